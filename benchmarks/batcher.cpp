@@ -0,0 +1,71 @@
+/**
+ * @file batcher.cpp
+ * @brief Benchmarks of outbound batching.
+ *
+ * @details
+ * Each iteration sends a frame of creation events over the loop-back address and receives them.
+ * With batching, the frame is flushed once as a due timer would do.
+ * System calls per event are reported as a counter.
+ */
+
+#include "common.h"
+
+#include "network/batcher.h"
+#include "network/stream_reader.h"
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace {
+
+//! The number of events placed in a frame.
+constexpr std::int64_t frame_events{ 32 };
+
+//! A creation event.
+struct NewItem : net::Header {
+    std::int32_t role;
+    std::int32_t pos_x;
+    std::int32_t pos_y;
+    std::int32_t id;
+};
+
+void BM_Batching(benchmark::State& state) {
+    auto [client, server]{ bench::LoopbackPair() };
+    bench::CountingSocket sender{ client };
+    bench::CountingSocket receiver{ server };
+    net::StreamReader reader{ receiver };
+
+    const std::chrono::microseconds delay{ state.range(0) };
+    net::Batcher batcher{ sender, delay };
+
+    NewItem item{};
+    for (auto _ : state) {
+        for (std::int64_t i{ 0 }; i != frame_events; ++i) {
+            item.id = static_cast<std::int32_t>(i);
+            batcher.Append(item);
+        }
+
+        batcher.Flush();
+        for (std::int64_t i{ 0 }; i != frame_events;) {
+            if (const auto pkg{ reader.Next() }) {
+                benchmark::DoNotOptimize(pkg->data());
+                ++i;
+            } else {
+                reader.Fill();
+            }
+        }
+    }
+
+    const auto events{ state.iterations() * frame_events };
+    state.counters["send_syscalls_per_event"] =
+        static_cast<double>(sender.Calls()) / static_cast<double>(events);
+    state.counters["recv_syscalls_per_event"] =
+        static_cast<double>(receiver.Calls()) / static_cast<double>(events);
+    state.SetItemsProcessed(events);
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_Batching)->ArgName("delay_us")->Arg(0)->Arg(2000);
@@ -0,0 +1,210 @@
+/**
+ * @file codec.cpp
+ * @brief Benchmarks of the fixed and compact packet encodings.
+ *
+ * @details
+ * Creation events on the game grid are encoded into a stream and decoded from it.
+ * Encoded bytes per event are reported as a counter.
+ * A compact stream of malformed prefixes must be rejected before the reader grows beyond the maximum packet size.
+ */
+
+#include "common.h"
+
+#include "netpkg/codec.h"
+#include "network/packet_view.h"
+#include "network/stream_reader.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+
+using namespace game;
+
+//! The number of events encoded or decoded in an iteration.
+constexpr std::size_t frame_events{ 256 };
+
+//! The maximum packet size of a reader of malformed streams.
+constexpr std::size_t malformed_max_packet_size{ 64 };
+
+//! The number of fills after which a malformed stream counts as accepted.
+constexpr std::size_t malformed_max_fills{ 32 };
+
+//! A stream socket receiving the same byte forever.
+class ConstantSocket {
+public:
+    explicit ConstantSocket(const std::byte byte) noexcept : byte_{ byte } {}
+
+    std::size_t Send(const std::span<const std::byte> data) noexcept {
+        return data.size();
+    }
+
+    std::size_t Recv(const std::span<std::byte> buffer) noexcept {
+        std::ranges::fill(buffer, byte_);
+        return buffer.size();
+    }
+
+private:
+    std::byte byte_;
+};
+
+//! Create creation events with random locations on the grid.
+std::vector<netpkg::NewItem> MakeEvents() {
+    std::mt19937 rand{ 0 };
+    std::vector<netpkg::NewItem> events(frame_events);
+    netpkg::Tick tick{ 0 };
+    for (auto& event : events) {
+        const auto plant{ rand() % 2 == 0 };
+        const auto pos_x{ static_cast<std::int32_t>(rand() % 9) };
+        const auto pos_y{ static_cast<std::int32_t>(rand() % 5) };
+        const auto id{ static_cast<std::int32_t>(rand() % 40) };
+        tick += rand() % 10;
+        event = plant ? netpkg::NewPlantMessage::Make(Role::Plant, pos_x,
+                                                      pos_y, id, tick)
+                      : netpkg::NewZombieMessage::Make(Role::Zombie, pos_x,
+                                                       pos_y, id, tick);
+        event.seq = static_cast<std::uint32_t>(&event - events.data()) + 1;
+    }
+
+    return events;
+}
+
+//! Encode events into a stream.
+std::vector<std::byte> Encode(const std::vector<netpkg::NewItem>& events,
+                              const bool compact) {
+    std::vector<std::byte> stream{};
+    netpkg::CompactEncoder encoder{};
+    for (const auto& event : events) {
+        if (compact) {
+            std::array<std::byte, netpkg::CompactEncoder::max_packet_size>
+                buffer{};
+            const auto size{ encoder.Encode(bench::AsBytes(event), buffer) };
+            stream.insert(stream.end(), buffer.begin(), buffer.begin() + size);
+        } else {
+            const auto bytes{ bench::AsBytes(event) };
+            stream.insert(stream.end(), bytes.begin(), bytes.end());
+        }
+    }
+
+    return stream;
+}
+
+void BM_EncodeEvents(benchmark::State& state) {
+    const auto compact{ state.range(0) != 0 };
+    const auto events{ MakeEvents() };
+    std::vector<std::byte> stream(frame_events * sizeof(netpkg::NewItem));
+
+    netpkg::CompactEncoder encoder{};
+    std::size_t size{ 0 };
+    for (auto _ : state) {
+        size = 0;
+        for (const auto& event : events) {
+            if (compact) {
+                size += encoder.Encode(
+                    bench::AsBytes(event),
+                    std::span{ stream }
+                        .subspan(size)
+                        .first<netpkg::CompactEncoder::max_packet_size>());
+            } else {
+                std::memcpy(stream.data() + size, &event, sizeof(event));
+                size += sizeof(event);
+            }
+        }
+
+        benchmark::DoNotOptimize(stream.data());
+    }
+
+    state.counters["bytes_per_event"] =
+        static_cast<double>(size) / static_cast<double>(frame_events);
+    state.SetItemsProcessed(state.iterations() * frame_events);
+}
+
+//! Walk through a stream and call a handler with each packet.
+template <net::Framing FRAMING, typename HANDLER>
+void ForEachPacket(std::span<const std::byte> stream, HANDLER handler) {
+    while (!stream.empty()) {
+        const auto size{ FRAMING::FrameSize(stream).value() };
+        handler(stream.first(size));
+        stream = stream.subspan(size);
+    }
+}
+
+void BM_DecodeEvents(benchmark::State& state) {
+    const auto compact{ state.range(0) != 0 };
+    const auto stream{ Encode(MakeEvents(), compact) };
+
+    for (auto _ : state) {
+        std::int32_t sum{ 0 };
+        if (compact) {
+            netpkg::CompactDecoder decoder{};
+            ForEachPacket<net::VarintFraming>(
+                stream, [&decoder, &sum](const auto pkg) {
+                    std::array<std::byte, netpkg::Messages::max_size> buffer;
+                    const net::PacketView<netpkg::NewItem> item{
+                        decoder.Decode(pkg, buffer)
+                    };
+                    sum += item.Get(&netpkg::NewItem::pos_x)
+                           + item.Get(&netpkg::NewItem::pos_y)
+                           + item.Get(&netpkg::NewItem::id)
+                           + static_cast<std::int32_t>(
+                               item.Get(&netpkg::NewItem::seq));
+                });
+        } else {
+            ForEachPacket<net::HeaderFraming>(stream, [&sum](const auto pkg) {
+                const net::PacketView<netpkg::NewItem> item{ pkg };
+                sum += item.Get(&netpkg::NewItem::pos_x)
+                       + item.Get(&netpkg::NewItem::pos_y)
+                       + item.Get(&netpkg::NewItem::id)
+                       + static_cast<std::int32_t>(
+                           item.Get(&netpkg::NewItem::seq));
+            });
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["bytes_per_event"] =
+        static_cast<double>(stream.size()) / static_cast<double>(frame_events);
+    state.SetItemsProcessed(state.iterations() * frame_events);
+}
+
+void BM_MalformedStream(benchmark::State& state) {
+    ConstantSocket socket{ static_cast<std::byte>(state.range(0)) };
+    for (auto _ : state) {
+        net::StreamReader<ConstantSocket, net::VarintFraming> reader{
+            socket, net::VarintFraming::max_prefix_size,
+            malformed_max_packet_size
+        };
+
+        auto rejected{ false };
+        for (std::size_t i{ 0 }; i != malformed_max_fills && !rejected; ++i) {
+            try {
+                reader.Fill();
+                while (reader.Next()) {
+                }
+            } catch (const std::runtime_error&) {
+                rejected = true;
+            }
+        }
+
+        if (!rejected) {
+            state.SkipWithError("A malformed stream has been accepted.");
+            return;
+        }
+    }
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_EncodeEvents)->ArgName("compact")->Arg(0)->Arg(1);
+BENCHMARK(BM_DecodeEvents)->ArgName("compact")->Arg(0)->Arg(1);
+// An over-long size, and a prefix that never ends.
+BENCHMARK(BM_MalformedStream)->ArgName("byte")->Arg(0x7F)->Arg(0xFF);
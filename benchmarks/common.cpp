@@ -0,0 +1,117 @@
+#include "common.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+
+namespace {
+
+std::atomic<std::size_t> allocations{ 0 };
+
+}  // namespace
+
+
+void* operator new(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (const auto ptr{ std::malloc(size == 0 ? 1 : size) }; ptr != nullptr) {
+        return ptr;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* const ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* const ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+
+namespace bench {
+
+std::size_t Allocations() noexcept {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+net::Packet MakePacket(const std::size_t body_size) {
+    net::Packet pkg{};
+    std::array<std::byte, sizeof(net::Header)> header{};
+    net::StoreHeader({ static_cast<std::uint32_t>(body_size) }, header);
+    pkg.Write(header);
+    pkg.Write(std::vector<std::byte>(body_size));
+    return pkg;
+}
+
+std::pair<net::TcpSocket<net::Ipv4Addr>, net::TcpSocket<net::Ipv4Addr>>
+LoopbackPair() {
+    net::TcpSocket<net::Ipv4Addr> listener{};
+    listener.SetAddr(net::Ipv4Addr{ net::Ipv4Addr::loop_back, 0 });
+    listener.Bind();
+    if (listen(listener.ID(), 1) == net::socket_error) {
+        net::ThrowLastSocketError();
+    }
+
+    sockaddr_in addr{};
+    net::SockLen size{ sizeof(addr) };
+    if (getsockname(listener.ID(), reinterpret_cast<sockaddr*>(&addr), &size)
+        == net::socket_error) {
+        net::ThrowLastSocketError();
+    }
+
+    net::TcpSocket<net::Ipv4Addr> client{};
+    client.Connect(net::Ipv4Addr{ addr });
+
+    const auto id{ accept(listener.ID(), nullptr, nullptr) };
+    if (id == net::invalid_socket) {
+        net::ThrowLastSocketError();
+    }
+
+    return { std::move(client), net::TcpSocket<net::Ipv4Addr>{ id } };
+}
+
+std::pair<net::TcpSocket<net::Ipv4Addr>, net::TcpSocket<net::Ipv4Addr>>
+SocketPair() {
+    std::array<net::SocketId, 2> ids{};
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, ids.data()) == net::socket_error) {
+        net::ThrowLastSocketError();
+    }
+
+    return { net::TcpSocket<net::Ipv4Addr>{ ids[0] },
+             net::TcpSocket<net::Ipv4Addr>{ ids[1] } };
+}
+
+
+void LatencyRecorder::Start() noexcept {
+    begin_ = Clock::now();
+}
+
+void LatencyRecorder::Stop() {
+    const std::chrono::duration<double, std::micro> elapsed{ Clock::now()
+                                                             - begin_ };
+    samples_.push_back(elapsed.count());
+}
+
+void LatencyRecorder::Report(benchmark::State& state) {
+    if (samples_.empty()) {
+        return;
+    }
+
+    std::ranges::sort(samples_);
+    const auto at{ [this](const double percentile) {
+        const auto idx{ static_cast<std::size_t>(
+            percentile * static_cast<double>(samples_.size() - 1)) };
+        assert(idx < samples_.size());
+        return samples_[idx];
+    } };
+
+    state.counters["p50_us"] = at(0.50);
+    state.counters["p99_us"] = at(0.99);
+}
+
+}  // namespace bench
@@ -0,0 +1,120 @@
+/**
+ * @file common.h
+ * @brief Shared helpers of benchmarks.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "network/ip_addr.h"
+#include "network/packet.h"
+#include "network/socket/tcp.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+//! Get the number of heap allocations made by the process so far.
+std::size_t Allocations() noexcept;
+
+//! Get the object representation of a value.
+template <typename T>
+std::span<const std::byte> AsBytes(const T& val) noexcept {
+    return { reinterpret_cast<const std::byte*>(&val), sizeof(val) };
+}
+
+/**
+ * @brief Create a packet with a zero-filled body.
+ *
+ * @param body_size The body size.
+ */
+net::Packet MakePacket(std::size_t body_size);
+
+/**
+ * @brief Create a pair of TCP sockets connected over the IPv4 loop-back address.
+ *
+ * @return A client and a server.
+ */
+std::pair<net::TcpSocket<net::Ipv4Addr>, net::TcpSocket<net::Ipv4Addr>>
+LoopbackPair();
+
+/**
+ * @brief Create a pair of connected Unix domain stream sockets.
+ *
+ * @details They skip the TCP stack, so only the cost of the packet layer and system calls is measured.
+ *
+ * @return Two sockets.
+ */
+std::pair<net::TcpSocket<net::Ipv4Addr>, net::TcpSocket<net::Ipv4Addr>>
+SocketPair();
+
+//! Collect latency samples of benchmark iterations.
+class LatencyRecorder {
+public:
+    //! Start to time an iteration.
+    void Start() noexcept;
+
+    //! Stop timing an iteration.
+    void Stop();
+
+    //! Report the 50th and 99th percentiles in microseconds as counters.
+    void Report(benchmark::State& state);
+
+private:
+    Clock::time_point begin_{};
+
+    std::vector<double> samples_{};
+};
+
+//! A stream socket that counts its system calls.
+template <net::StreamSocket SOCKET>
+class CountingSocket {
+public:
+    explicit CountingSocket(SOCKET& socket) noexcept : socket_{ socket } {}
+
+    std::size_t Send(const std::span<const std::byte> data) {
+        ++calls_;
+        return socket_.Send(data);
+    }
+
+    std::size_t Send(const std::span<const std::span<const std::byte>> buffers)
+        requires net::VectoredStreamSocket<SOCKET>
+    {
+        ++calls_;
+        return socket_.Send(buffers);
+    }
+
+    std::size_t Recv(const std::span<std::byte> buffer) {
+        ++calls_;
+        return socket_.Recv(buffer);
+    }
+
+    //! Get the number of system calls.
+    std::size_t Calls() const noexcept {
+        return calls_;
+    }
+
+private:
+    SOCKET& socket_;
+
+    std::size_t calls_{ 0 };
+};
+
+}  // namespace bench
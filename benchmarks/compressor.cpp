@@ -0,0 +1,137 @@
+/**
+ * @file compressor.cpp
+ * @brief Benchmarks of stream compression.
+ *
+ * @details
+ * A synthetic recorded session repeats a few zombies and plants in a few lanes.
+ * It is compressed frame by frame as a spectator feed would be.
+ * The compression ratio of the whole stream and of its first frame,
+ * and the time to compress a frame are reported as counters.
+ */
+
+#include "common.h"
+
+#include "netpkg/dictionary.h"
+#include "netpkg/message.h"
+#include "network/compressor.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+
+namespace {
+
+using namespace game;
+
+//! The number of events in a frame.
+constexpr std::size_t frame_events{ 32 };
+
+//! The number of frames in a session.
+constexpr std::size_t session_frames{ 128 };
+
+//! Create a recorded session in the fixed layout.
+std::vector<std::byte> MakeSession() {
+    std::mt19937 rand{ 1 };
+    std::vector<std::byte> session{};
+    for (std::size_t i{ 0 }; i != frame_events * session_frames; ++i) {
+        const auto zombie{ rand() % 4 != 0 };
+        const auto pos_x{ zombie ? 8 : static_cast<std::int32_t>(rand() % 3) };
+        const auto id{ static_cast<std::int32_t>(zombie ? 2 + rand() % 3
+                                                        : rand() % 4) };
+        const auto pos_y{ static_cast<std::int32_t>(rand() % 5) };
+        // A frame of events is created in a tick.
+        const auto tick{ static_cast<netpkg::Tick>(i / frame_events) };
+        const auto item{
+            zombie ? netpkg::NewZombieMessage::Make(Role::Zombie, pos_x, pos_y,
+                                                    id, tick)
+                   : netpkg::NewPlantMessage::Make(Role::Plant, pos_x, pos_y,
+                                                   id, tick)
+        };
+        const auto bytes{ bench::AsBytes(item) };
+        session.insert(session.end(), bytes.begin(), bytes.end());
+    }
+
+    return session;
+}
+
+std::span<const std::byte> Dictionary(const benchmark::State& state) {
+    return state.range(0) != 0 ? netpkg::CompressionDictionary()
+                               : std::span<const std::byte>{};
+}
+
+void BM_CompressStream(benchmark::State& state) {
+    const auto session{ MakeSession() };
+    const auto frame_size{ session.size() / session_frames };
+    net::Compressor compressor{ Dictionary(state) };
+
+    std::vector<std::byte> out{};
+    out.reserve(net::Compressor::MaxCompressedSize(session.size()));
+    std::size_t first_frame{ 0 };
+    bench::LatencyRecorder latency{};
+    for (auto _ : state) {
+        compressor.Reset();
+        out.clear();
+        for (std::size_t i{ 0 }; i != session_frames; ++i) {
+            latency.Start();
+            compressor.Compress(
+                std::span{ session }.subspan(i * frame_size, frame_size), out);
+            latency.Stop();
+            if (i == 0) {
+                first_frame = out.size();
+            }
+        }
+
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    latency.Report(state);
+    state.counters["ratio"] =
+        static_cast<double>(session.size()) / static_cast<double>(out.size());
+    state.counters["first_frame_ratio"] =
+        static_cast<double>(frame_size) / static_cast<double>(first_frame);
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<std::int64_t>(session.size()));
+}
+
+void BM_DecompressStream(benchmark::State& state) {
+    const auto session{ MakeSession() };
+    const auto frame_size{ session.size() / session_frames };
+
+    net::Compressor compressor{ Dictionary(state) };
+    std::vector<std::vector<std::byte>> blocks(session_frames);
+    for (std::size_t i{ 0 }; i != session_frames; ++i) {
+        compressor.Compress(
+            std::span{ session }.subspan(i * frame_size, frame_size),
+            blocks[i]);
+    }
+
+    net::Decompressor decompressor{ Dictionary(state) };
+    std::vector<std::byte> out{};
+    out.reserve(session.size());
+    for (auto _ : state) {
+        decompressor.Reset();
+        out.clear();
+        for (const auto& block : blocks) {
+            decompressor.Decompress(block, out);
+        }
+
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    if (out != session) {
+        state.SkipWithError("The decompressed stream is different.");
+    }
+
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<std::int64_t>(session.size()));
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_CompressStream)->ArgName("dictionary")->Arg(0)->Arg(1);
+BENCHMARK(BM_DecompressStream)->ArgName("dictionary")->Arg(0)->Arg(1);
@@ -0,0 +1,87 @@
+/**
+ * @file connector.cpp
+ * @brief Benchmarks of resolving and connecting.
+ *
+ * @details
+ * Resolving a host name with the system resolver is compared with reading a cached result.
+ *
+ * When connecting, the first address is a loop-back server whose accept queue is full, so its handshakes hang,
+ * and the second one is a live server.
+ * Sequential connecting would wait for the system timeout of the dead path,
+ * while raced attempts connect after the attempt delay.
+ */
+
+#include "common.h"
+
+#include "network/connector.h"
+#include "network/listener.h"
+#include "network/resolver.h"
+
+#include <chrono>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using Socket = net::TcpSocket<net::SockAddr>;
+
+void BM_ConnectDeadPath(benchmark::State& state) {
+    const std::chrono::milliseconds attempt_delay{ state.range(0) };
+
+    // Linux keeps one more connection than the backlog in the accept queue,
+    // and drops handshakes when it is full.
+    net::Listener<net::SockAddr> dead{};
+    dead.Bind(net::SockAddr{ net::Ipv4Addr::loop_back, 0 });
+    dead.Listen(0);
+    Socket filler{ dead.LocalAddr() };
+    filler.Connect(dead.LocalAddr());
+
+    net::Listener<net::SockAddr> live{};
+    live.Bind(net::SockAddr{ net::Ipv4Addr::loop_back, 0 });
+    live.Listen();
+
+    const std::vector addrs{ dead.LocalAddr(), live.LocalAddr() };
+    const net::ConnectOptions options{ .timeout{ 2s },
+                                       .attempt_delay{ attempt_delay } };
+    for (auto _ : state) {
+        try {
+            auto socket{ net::ConnectAny(addrs, options) };
+            state.PauseTiming();
+            live.Accept();
+            state.ResumeTiming();
+        } catch (const std::system_error& err) {
+            state.SkipWithError(err.what());
+            return;
+        }
+    }
+}
+
+void BM_ResolveHost(benchmark::State& state) {
+    const auto cached{ state.range(0) != 0 };
+
+    constexpr std::string_view host{ "localhost" };
+    net::Resolver resolver{};
+    for (auto _ : state) {
+        if (!cached) {
+            resolver.Clear();
+        }
+
+        benchmark::DoNotOptimize(resolver.Resolve(host, 0));
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_ResolveHost)->ArgName("cached")->Arg(0)->Arg(1);
+
+BENCHMARK(BM_ConnectDeadPath)
+    ->ArgName("attempt_delay_ms")
+    ->Arg(50)
+    ->Arg(250)
+    ->Iterations(4)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
@@ -0,0 +1,264 @@
+/**
+ * @file event.cpp
+ * @brief Benchmarks of creation events from the wire to the game.
+ *
+ * @details
+ * The game is replaced by a stub backend that counts created items,
+ * and packets are dispatched by the same @p netpkg::EventDispatcher as the game's.
+ * Dispatch is measured on a buffered stream, with a share of packets of unknown types.
+ * Events are also passed through the inbound queue from a receiver thread to the game thread,
+ * and through the outbound queue from the game thread to a sender thread.
+ * Round trips of single events are measured over the loop-back address.
+ */
+
+#include "common.h"
+
+#include "netpkg/dispatch.h"
+#include "netpkg/inbound.h"
+#include "netpkg/outbound.h"
+#include "network/packet_view.h"
+#include "network/stream_reader.h"
+
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+using namespace game;
+
+//! The number of events dispatched in an iteration.
+constexpr std::size_t frame_events{ 256 };
+
+//! The number of packets of unknown types per 100 in @p BM_Dispatch.
+constexpr std::size_t unknown_percent{ 10 };
+
+//! A receiver that counts created items.
+struct StubGame {
+    void CreatePlant(const std::int32_t pos_x, const std::int32_t pos_y,
+                     const std::int32_t id, const netpkg::Tick tick) noexcept {
+        ++plants;
+        checksum += pos_x + pos_y + id + tick;
+    }
+
+    void CreateZombie(const std::int32_t pos_x, const std::int32_t pos_y,
+                      const std::int32_t id, const netpkg::Tick tick) noexcept {
+        ++zombies;
+        checksum += pos_x + pos_y + id + tick;
+    }
+
+    void Confirm(const netpkg::Tick tick) noexcept {
+        checksum += tick;
+    }
+
+    void EndLevel() noexcept {
+        ++level_ends;
+    }
+
+    std::int64_t plants{ 0 };
+    std::int64_t zombies{ 0 };
+    std::int64_t level_ends{ 0 };
+    std::int64_t checksum{ 0 };
+};
+
+//! Create a random creation event on the grid.
+netpkg::NewItem MakeEvent(std::mt19937& rand) {
+    const auto plant{ rand() % 2 == 0 };
+    const auto pos_x{ static_cast<std::int32_t>(rand() % 9) };
+    const auto pos_y{ static_cast<std::int32_t>(rand() % 5) };
+    const auto id{ static_cast<std::int32_t>(rand() % 40) };
+    const auto tick{ static_cast<netpkg::Tick>(rand() % 1000) };
+    return plant ? netpkg::NewPlantMessage::Make(Role::Plant, pos_x, pos_y, id,
+                                                 tick)
+                 : netpkg::NewZombieMessage::Make(Role::Zombie, pos_x, pos_y,
+                                                  id, tick);
+}
+
+/**
+ * @brief Create a buffered stream of sealed events for a frame.
+ *
+ * @param unknown Whether to replace a share of events with packets of unknown types.
+ */
+std::vector<std::byte> MakeStream(const bool unknown) {
+    std::mt19937 rand{ 0 };
+    std::vector<std::byte> stream{};
+    for (std::size_t i{ 0 }; i != frame_events; ++i) {
+        auto event{ MakeEvent(rand) };
+        if (unknown && rand() % 100 < unknown_percent) {
+            event.type = std::numeric_limits<std::uint16_t>::max();
+        }
+
+        net::Seal(std::as_writable_bytes(std::span{ &event, 1 }));
+        const auto bytes{ bench::AsBytes(event) };
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+    }
+
+    return stream;
+}
+
+//! Dispatch every packet in a buffered stream.
+template <typename DISPATCHER>
+void DispatchStream(DISPATCHER& dispatcher,
+                    const std::span<const std::byte> stream) {
+    for (auto rest{ stream }; !rest.empty();) {
+        const auto size{ net::HeaderFraming::FrameSize(rest).value() };
+        dispatcher.Dispatch(rest.first(size));
+        rest = rest.subspan(size);
+    }
+}
+
+void BM_Dispatch(benchmark::State& state) {
+    const auto stream{ MakeStream(state.range(0) != 0) };
+    StubGame game{};
+    netpkg::EventDispatcher<StubGame> dispatcher{ game };
+    for (auto _ : state) {
+        DispatchStream(dispatcher, stream);
+    }
+
+    benchmark::DoNotOptimize(game.checksum);
+    state.counters["unknown_per_frame"] =
+        static_cast<double>(dispatcher.Unknown())
+        / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * frame_events);
+}
+
+void BM_EventRoundTrip(benchmark::State& state) {
+    auto [client, server]{ bench::LoopbackPair() };
+    net::StreamReader reader{ server };
+
+    std::mt19937 rand{ 0 };
+    auto event{ MakeEvent(rand) };
+    if (state.range(0) != 0) {
+        event.flags = static_cast<std::uint8_t>(net::HeaderFlag::Checksum);
+    }
+
+    // The server processes each event and echoes it back.
+    StubGame game{};
+    netpkg::EventDispatcher<StubGame> dispatcher{ game };
+    bench::LatencyRecorder latency{};
+    for (auto _ : state) {
+        latency.Start();
+        net::Packet::Send(client, event);
+
+        std::optional<std::span<const std::byte>> pkg{};
+        while (!(pkg = reader.Next())) {
+            if (reader.Fill() == 0) {
+                state.SkipWithError("The connection has been closed.");
+                return;
+            }
+        }
+
+        dispatcher.Dispatch(*pkg);
+        server.Send(*pkg);
+        benchmark::DoNotOptimize(net::Packet::Recv(client));
+        latency.Stop();
+    }
+
+    latency.Report(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_InboundQueue(benchmark::State& state) {
+    const auto stream{ MakeStream(false) };
+    netpkg::InboundQueue queue{};
+
+    // The receiver thread queues a frame of events each time one is requested.
+    std::atomic<std::int64_t> requested{ 0 };
+    std::jthread receiver{ [&](const std::stop_token stop_token) {
+        netpkg::EventDispatcher<netpkg::InboundQueue> dispatcher{ queue };
+        for (std::int64_t sent{ 0 }; !stop_token.stop_requested();) {
+            if (sent == requested.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            } else {
+                DispatchStream(dispatcher, stream);
+                ++sent;
+            }
+        }
+    } };
+
+    // The game thread applies events as they arrive.
+    StubGame game{};
+    for (auto _ : state) {
+        requested.fetch_add(1, std::memory_order_release);
+        for (std::size_t applied{ 0 }; applied != frame_events;) {
+            const auto count{ queue.Drain(game) };
+            if (count == 0) {
+                std::this_thread::yield();
+            }
+
+            applied += count;
+        }
+    }
+
+    receiver.request_stop();
+    receiver.join();
+
+    const auto stats{ queue.Stats() };
+    state.counters["max_depth"] = static_cast<double>(stats.max_depth);
+    state.counters["mean_latency_us"] =
+        std::chrono::duration<double, std::micro>{ stats.total_latency }.count()
+        / static_cast<double>(stats.applied);
+    state.SetItemsProcessed(state.iterations() * frame_events);
+}
+
+void BM_OutboundQueue(benchmark::State& state) {
+    std::mt19937 rand{ 0 };
+    std::vector<netpkg::NewItem> events(frame_events);
+    std::ranges::generate(events, [&rand] { return MakeEvent(rand); });
+
+    // The sender thread seals each packet as the game's does.
+    netpkg::OutboundQueue queue{};
+    std::atomic<std::int64_t> sent{ 0 };
+    std::jthread sender{ [&](const std::stop_token stop_token) {
+        const auto seal{ [](const std::span<std::byte> pkg) {
+            net::Seal(pkg);
+        } };
+        while (!stop_token.stop_requested()) {
+            queue.Wait(stop_token);
+            const auto count{ queue.Drain(seal) };
+            sent.fetch_add(static_cast<std::int64_t>(count),
+                           std::memory_order_relaxed);
+        }
+    } };
+
+    // The game thread queues a frame of events and never waits for the network.
+    std::size_t max_depth{ 0 };
+    for (auto _ : state) {
+        while (queue.Depth() > netpkg::OutboundQueue::capacity - frame_events) {
+            std::this_thread::yield();
+        }
+
+        for (const auto& event : events) {
+            queue.Push(bench::AsBytes(event));
+        }
+
+        max_depth = std::max(max_depth, queue.Depth());
+    }
+
+    sender.request_stop();
+    sender.join();
+
+    state.counters["max_depth"] = static_cast<double>(max_depth);
+    state.counters["sent_per_frame"] =
+        static_cast<double>(sent.load())
+        / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * frame_events);
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_Dispatch)->ArgName("unknown")->Arg(0)->Arg(1);
+BENCHMARK(BM_InboundQueue)->UseRealTime();
+BENCHMARK(BM_OutboundQueue);
+BENCHMARK(BM_EventRoundTrip)->ArgName("checksum")->Arg(0)->Arg(1);
@@ -0,0 +1,69 @@
+/**
+ * @file ip_addr.cpp
+ * @brief Benchmarks of IP address construction.
+ *
+ * @details
+ * Addresses are parsed from numeric strings, as the configured server address is,
+ * and copied from low-level socket addresses, as accepted clients are.
+ */
+
+#include "common.h"
+
+#include "network/ip_addr.h"
+
+#include <cstdint>
+#include <string>
+
+
+namespace {
+
+constexpr std::uint16_t port{ 10000 };
+
+void BM_Ipv4AddrFromString(benchmark::State& state) {
+    const std::string ip{ "192.168.100.200" };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(net::Ipv4Addr{ ip, port });
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Ipv6AddrFromString(benchmark::State& state) {
+    const std::string ip{ "2001:db8:85a3::8a2e:370:7334" };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(net::Ipv6Addr{ ip, port });
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SockAddrFromString(benchmark::State& state) {
+    const std::string ip{ state.range(0) == 4 ? "192.168.100.200"
+                                              : "2001:db8:85a3::8a2e:370:7334" };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(net::SockAddr{ ip, port });
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SockAddrFromRaw(benchmark::State& state) {
+    const net::SockAddr src{ state.range(0) == 4
+                                 ? net::SockAddr{ net::Ipv4Addr::loop_back,
+                                                  port }
+                                 : net::SockAddr{ net::Ipv6Addr::loop_back,
+                                                  port } };
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(net::SockAddr{ src.Raw(), src.Size() });
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_Ipv4AddrFromString);
+BENCHMARK(BM_Ipv6AddrFromString);
+BENCHMARK(BM_SockAddrFromString)->ArgName("version")->Arg(4)->Arg(6);
+BENCHMARK(BM_SockAddrFromRaw)->ArgName("version")->Arg(4)->Arg(6);
@@ -0,0 +1,117 @@
+/**
+ * @file listener.cpp
+ * @brief Benchmarks of accepting bursts of connections.
+ *
+ * @details
+ * Each iteration connects a burst of clients and waits until the server has accepted all of them.
+ * Accepting one connection per wake-up costs an event loop round trip for each connection,
+ * while batched accepting drains the queue after a single wake-up.
+ */
+
+#include "common.h"
+
+#include "network/listener.h"
+#include "network/reactor.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+
+namespace {
+
+using Socket = net::TcpSocket<net::Ipv4Addr>;
+
+//! The number of clients in a burst.
+constexpr std::size_t burst_size{ 32 };
+
+//! Connect a burst of clients to a server.
+void ConnectBurst(const net::Ipv4Addr& addr, std::vector<Socket>& clients) {
+    for (std::size_t i{ 0 }; i != burst_size; ++i) {
+        clients.emplace_back().Connect(addr);
+    }
+}
+
+void BM_AcceptBatch(benchmark::State& state) {
+    const auto max_batch{ static_cast<std::size_t>(state.range(0)) };
+
+    net::Listener<net::Ipv4Addr> listener{};
+    listener.Bind(net::Ipv4Addr{ net::Ipv4Addr::loop_back, 0 });
+    listener.Listen();
+    listener.SetNonBlocking(true);
+    const auto addr{ listener.LocalAddr() };
+
+    std::vector<Socket> accepted{};
+    std::size_t wakeups{ 0 };
+    net::Reactor reactor{};
+    reactor.Watch(listener.ID(), net::Event::Read, [&](net::Event) {
+        listener.AcceptBatch(accepted, max_batch);
+    });
+
+    std::vector<Socket> clients{};
+    for (auto _ : state) {
+        ConnectBurst(addr, clients);
+        while (accepted.size() != burst_size) {
+            reactor.RunOnce(std::nullopt);
+            ++wakeups;
+        }
+
+        state.PauseTiming();
+        clients.clear();
+        accepted.clear();
+        state.ResumeTiming();
+    }
+
+    state.counters["wakeups_per_conn"]
+        = static_cast<double>(wakeups)
+          / static_cast<double>(state.iterations() * burst_size);
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * burst_size));
+}
+
+void BM_ShardedAccept(benchmark::State& state) {
+    const auto shards{ static_cast<std::size_t>(state.range(0)) };
+
+    std::atomic_size_t accepted{ 0 };
+    net::ShardedListener<net::Ipv4Addr> listener{
+        net::Ipv4Addr{ net::Ipv4Addr::loop_back, 0 },
+        [&accepted](Socket) { accepted.fetch_add(1); }, shards
+    };
+
+    const auto addr{ listener.LocalAddr() };
+    std::vector<Socket> clients{};
+    std::size_t expected{ 0 };
+    for (auto _ : state) {
+        ConnectBurst(addr, clients);
+        expected += burst_size;
+        while (accepted.load() != expected) {
+            if (listener.Error()) {
+                state.SkipWithError("A shard has failed.");
+                return;
+            }
+
+            std::this_thread::yield();
+        }
+
+        state.PauseTiming();
+        clients.clear();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(
+        static_cast<std::int64_t>(state.iterations() * burst_size));
+}
+
+}  // namespace
+
+BENCHMARK(BM_AcceptBatch)->ArgName("max_batch")->Arg(1)->Arg(burst_size);
+
+BENCHMARK(BM_ShardedAccept)
+    ->ArgName("shards")
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->UseRealTime();
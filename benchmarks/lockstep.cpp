@@ -0,0 +1,282 @@
+/**
+ * @file lockstep.cpp
+ * @brief Benchmarks of the lockstep scheduler with two in-process peers.
+ *
+ * @details
+ * Both sides of a level run on a simulated clock and exchange packets over simulated links,
+ * which deliver them in order after a latency with jitter.
+ * Each side records the tick in which every item appears on its board.
+ * Items that appear in different ticks or orders are reported as a counter,
+ * which stays zero with the stall policy whatever the latency is.
+ * It must also stay zero with any policy if the input delay covers the latency,
+ * and the timeline must not fall behind the clock by more than the latency beyond the input delay.
+ */
+
+#include "common.h"
+
+#include "netpkg/dispatch.h"
+#include "netpkg/lockstep.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace {
+
+using namespace game;
+
+using Clock = netpkg::LockstepScheduler::Clock;
+
+//! The number of ticks in which items are created, which is one minute.
+constexpr netpkg::Tick level_ticks{ 6000 };
+
+//! The number of ticks run after the level, so all events are applied.
+constexpr netpkg::Tick tail_ticks{ 100 };
+
+//! A side creates an item in one of this number of ticks on average.
+constexpr std::uint32_t create_odds{ 50 };
+
+//! The maximum jitter added to the latency.
+constexpr std::chrono::milliseconds max_jitter{ 10 };
+
+//! An item appearing on a board.
+struct Item {
+    netpkg::Tick tick;
+    netpkg::Type type;
+    std::int32_t pos_x;
+    std::int32_t pos_y;
+    std::int32_t id;
+
+    bool operator==(const Item&) const noexcept = default;
+};
+
+//! A board recording the tick in which each item appears.
+class Board {
+public:
+    explicit Board(const netpkg::LockstepScheduler& timeline) noexcept :
+        timeline_{ timeline } {}
+
+    void CreatePlant(const std::int32_t pos_x, const std::int32_t pos_y,
+                     const std::int32_t id) {
+        items_.push_back({ timeline_.Current(), netpkg::Type::NewPlant, pos_x,
+                           pos_y, id });
+    }
+
+    void CreateZombie(const std::int32_t pos_x, const std::int32_t pos_y,
+                      const std::int32_t id) {
+        items_.push_back({ timeline_.Current(), netpkg::Type::NewZombie, pos_x,
+                           pos_y, id });
+    }
+
+    void EndLevel() noexcept {}
+
+    const std::vector<Item>& Items() const noexcept {
+        return items_;
+    }
+
+private:
+    const netpkg::LockstepScheduler& timeline_;
+    std::vector<Item> items_{};
+};
+
+//! A one-way link delivering packets in order after a latency with jitter.
+class Link {
+public:
+    Link(const Clock::duration latency, const std::uint32_t seed) noexcept :
+        latency_{ latency }, rand_{ seed } {}
+
+    void Send(const Clock::time_point now,
+              const std::span<const std::byte> packet) {
+        const auto jitter{ std::chrono::microseconds{
+            rand_() % std::chrono::microseconds{ max_jitter }.count() } };
+        last_arrival_ = std::max(now + latency_ + jitter, last_arrival_);
+        packets_.push_back({ last_arrival_, { packet.begin(), packet.end() } });
+    }
+
+    //! Dispatch packets that have arrived by a time.
+    template <typename DISPATCHER>
+    void Deliver(const Clock::time_point now, DISPATCHER& dispatcher) {
+        while (!packets_.empty() && packets_.front().arrival <= now) {
+            dispatcher.Dispatch(packets_.front().data);
+            packets_.pop_front();
+        }
+    }
+
+private:
+    struct Packet {
+        Clock::time_point arrival;
+        std::vector<std::byte> data;
+    };
+
+    Clock::duration latency_;
+    std::minstd_rand rand_;
+    Clock::time_point last_arrival_{};
+    std::deque<Packet> packets_{};
+};
+
+/**
+ * @brief A side of a level.
+ *
+ * @tparam BOARD A game created with the timeline.
+ */
+template <typename BOARD>
+class Peer {
+public:
+    Peer(const Role role, const netpkg::LockstepOptions& options,
+         Link& outbound, Link& inbound) noexcept :
+        role_{ role },
+        timeline_{ role, options },
+        outbound_{ outbound },
+        inbound_{ inbound } {}
+
+    //! Run a tick, creating an item by chance.
+    void Step(const Clock::time_point now, std::mt19937& rand,
+              const bool create) {
+        inbound_.Deliver(now, dispatcher_);
+        if (create && rand() % create_odds == 0) {
+            const auto pos_x{ static_cast<std::int32_t>(rand() % 9) };
+            const auto pos_y{ static_cast<std::int32_t>(rand() % 5) };
+            const auto id{ static_cast<std::int32_t>(rand() % 40) };
+            const auto type{ role_ == Role::Plant ? netpkg::Type::NewPlant
+                                                  : netpkg::Type::NewZombie };
+            const auto tick{ timeline_.Schedule({ .type{ type },
+                                                  .pos_x{ pos_x },
+                                                  .pos_y{ pos_y },
+                                                  .id{ id } }) };
+            const auto item{
+                role_ == Role::Plant
+                    ? netpkg::NewPlantMessage::Make(role_, pos_x, pos_y, id,
+                                                    tick)
+                    : netpkg::NewZombieMessage::Make(role_, pos_x, pos_y, id,
+                                                     tick)
+            };
+            outbound_.Send(now, bench::AsBytes(item));
+        }
+
+        timeline_.Update(now, board_,
+                         [this, now](const netpkg::Heartbeat& heartbeat) {
+                             outbound_.Send(now, bench::AsBytes(heartbeat));
+                         });
+    }
+
+    const netpkg::LockstepScheduler& Timeline() const noexcept {
+        return timeline_;
+    }
+
+    const BOARD& Applied() const noexcept {
+        return board_;
+    }
+
+private:
+    Role role_;
+    netpkg::LockstepScheduler timeline_;
+    BOARD board_{ timeline_ };
+    netpkg::EventDispatcher<netpkg::LockstepScheduler> dispatcher_{
+        timeline_
+    };
+    Link& outbound_;
+    Link& inbound_;
+};
+
+/**
+ * @brief Get the maximum number of ticks a timeline may fall behind the clock.
+ *
+ * @details
+ * A timeline stalls until the peer's promise arrives, which is stamped an input delay ahead.
+ * It falls behind by the latency beyond the input delay,
+ * plus the ticks between heartbeats and a tick for rounding to ticks.
+ */
+netpkg::Tick MaxLag(const netpkg::LockstepOptions& options,
+                    const std::chrono::milliseconds latency) noexcept {
+    const auto delay{ options.tick_interval * options.input_delay };
+    if (latency + max_jitter <= delay) {
+        return 0;
+    }
+
+    return static_cast<netpkg::Tick>((latency + max_jitter - delay)
+                                     / options.tick_interval)
+           + options.input_delay / 2 + 2;
+}
+
+//! Count items that differ between two boards.
+std::size_t Diverged(const Board& lhs, const Board& rhs) noexcept {
+    const auto& lhs_items{ lhs.Items() };
+    const auto& rhs_items{ rhs.Items() };
+    const auto common{ std::min(lhs_items.size(), rhs_items.size()) };
+    auto count{ std::max(lhs_items.size(), rhs_items.size()) - common };
+    for (std::size_t i{ 0 }; i != common; ++i) {
+        if (lhs_items[i] != rhs_items[i]) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+void BM_Lockstep(benchmark::State& state) {
+    const netpkg::LockstepOptions options{
+        .policy{ state.range(0) == 0 ? netpkg::LatePolicy::Stall
+                                     : netpkg::LatePolicy::Skip }
+    };
+    const std::chrono::milliseconds latency{ state.range(1) };
+
+    std::size_t diverged{ 0 };
+    std::uint64_t items{ 0 };
+    std::uint64_t late{ 0 };
+    std::uint64_t stalls{ 0 };
+    netpkg::Tick max_lag{ 0 };
+    for (auto _ : state) {
+        Link to_zombie{ latency, 1 };
+        Link to_plant{ latency, 2 };
+        Peer<Board> plant{ Role::Plant, options, to_zombie, to_plant };
+        Peer<Board> zombie{ Role::Zombie, options, to_plant, to_zombie };
+
+        std::mt19937 rand{ 0 };
+        Clock::time_point now{};
+        for (netpkg::Tick tick{ 0 }; tick != level_ticks + tail_ticks;
+             ++tick) {
+            plant.Step(now, rand, tick < level_ticks);
+            zombie.Step(now, rand, tick < level_ticks);
+            now += options.tick_interval;
+        }
+
+        diverged += Diverged(plant.Applied(), zombie.Applied());
+        items += plant.Applied().Items().size();
+        for (const auto* const peer : { &plant, &zombie }) {
+            const auto& stats{ peer->Timeline().Stats() };
+            late += stats.late;
+            stalls += stats.stalls;
+            max_lag = std::max(max_lag, stats.max_lag);
+        }
+    }
+
+    const auto iterations{ static_cast<double>(state.iterations()) };
+    state.counters["diverged"] = static_cast<double>(diverged) / iterations;
+    state.counters["items"] = static_cast<double>(items) / iterations;
+    state.counters["late"] = static_cast<double>(late) / iterations;
+    state.counters["stalls"] = static_cast<double>(stalls) / iterations;
+    state.counters["max_lag"] = static_cast<double>(max_lag);
+    state.SetItemsProcessed(state.iterations() * (level_ticks + tail_ticks));
+
+    const auto lag_bound{ MaxLag(options, latency) };
+    if ((options.policy == netpkg::LatePolicy::Stall || lag_bound == 0)
+        && diverged != 0) {
+        state.SkipWithError("Items appear in different ticks on two boards.");
+    } else if (max_lag > lag_bound) {
+        state.SkipWithError("The timeline falls behind the clock.");
+    }
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_Lockstep)
+    ->ArgNames({ "skip", "latency_ms" })
+    ->ArgsProduct({ { 0, 1 }, { 20, 100 } });
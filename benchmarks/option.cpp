@@ -0,0 +1,89 @@
+/**
+ * @file option.cpp
+ * @brief Benchmarks of latency profiles.
+ *
+ * @details
+ * Each iteration sends two small events with separate calls and waits for a reply.
+ * Without tuning, the second event waits for the acknowledgement of the first one.
+ */
+
+#include "common.h"
+
+#include "network/socket/option.h"
+#include "network/stream_reader.h"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <thread>
+
+
+namespace {
+
+//! The body size of a creation event.
+constexpr std::size_t body_size{ 20 };
+
+const std::array profiles{ &net::LatencyProfile::standard,
+                           &net::LatencyProfile::low_latency,
+                           &net::LatencyProfile::busy_poll_latency,
+                           &net::LatencyProfile::throughput };
+
+void BM_LatencyProfile(benchmark::State& state) {
+    const auto& profile{ *profiles.at(static_cast<std::size_t>(
+        state.range(0))) };
+    state.SetLabel(std::string{ profile.name });
+
+    auto [client, server]{ bench::LoopbackPair() };
+    try {
+        client.Apply(profile);
+        server.Apply(profile);
+    } catch (const std::system_error& err) {
+        state.SkipWithError(err.what());
+        return;
+    }
+
+    // The peer replies to every two events until the connection is closed.
+    std::jthread peer{ [&server] {
+        net::StreamReader reader{ server };
+        auto reply{ bench::MakePacket(body_size) };
+        try {
+            for (std::size_t events{ 0 };;) {
+                while (reader.Next()) {
+                    if (++events % 2 == 0) {
+                        reply.Send(server);
+                    }
+                }
+
+                if (reader.Fill() == 0) {
+                    return;
+                }
+            }
+        } catch (const std::system_error&) {
+        }
+    } };
+
+    net::StreamReader reader{ client };
+    auto event{ bench::MakePacket(body_size) };
+    bench::LatencyRecorder latency{};
+    for (auto _ : state) {
+        latency.Start();
+        event.Send(client);
+        event.Send(client);
+        while (!reader.Next()) {
+            reader.Fill();
+        }
+
+        latency.Stop();
+    }
+
+    client.Close();
+    latency.Report(state);
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_LatencyProfile)
+    ->DenseRange(0, profiles.size() - 1)
+    ->UseRealTime();
@@ -0,0 +1,189 @@
+/**
+ * @file packet.cpp
+ * @brief Benchmarks of packet storage.
+ *
+ * @details
+ * Packets are written and read in memory, received over a Unix domain socket pair,
+ * either into packets or into frames of a receive arena,
+ * and sent and received over the loop-back address.
+ * Heap allocations per packet are reported as a counter.
+ * Creation events fit inline storage and larger bodies reuse pooled blocks,
+ * so both should make no allocations in the steady state.
+ *
+ * Sealing and verifying headers are measured with and without checksums.
+ */
+
+#include "common.h"
+
+#include "network/crc32c.h"
+#include "network/packet.h"
+#include "network/recv_arena.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+
+namespace {
+
+//! The number of packets received in an iteration, which fit the socket buffer.
+constexpr std::size_t recv_burst{ 8 };
+
+//! Report heap allocations per iteration since a count.
+void ReportAllocations(benchmark::State& state, const std::size_t begin) {
+    state.counters["allocs_per_packet"] =
+        static_cast<double>(bench::Allocations() - begin)
+        / static_cast<double>(state.iterations());
+}
+
+void BM_PacketWriteRead(benchmark::State& state) {
+    const auto body_size{ static_cast<std::size_t>(state.range(0)) };
+    std::array<std::byte, sizeof(net::Header)> header{};
+    net::StoreHeader({ static_cast<std::uint32_t>(body_size) }, header);
+    const std::vector<std::byte> body(body_size);
+
+    benchmark::DoNotOptimize(bench::MakePacket(body_size));
+
+    const auto begin{ bench::Allocations() };
+    for (auto _ : state) {
+        net::Packet pkg{};
+        pkg.Write(header);
+        pkg.Write(body);
+        benchmark::DoNotOptimize(pkg.Read().data());
+    }
+
+    ReportAllocations(state, begin);
+    state.SetBytesProcessed(
+        state.iterations()
+        * static_cast<std::int64_t>(sizeof(header) + body_size));
+}
+
+//! Create a burst of packets, which is written at once and then received packet by packet.
+std::vector<std::byte> MakeBurst(const std::size_t body_size) {
+    std::vector<std::byte> burst{};
+    const auto pkg{ bench::MakePacket(body_size) };
+    for (std::size_t i{ 0 }; i != recv_burst; ++i) {
+        burst.insert(burst.end(), pkg.Read().begin(), pkg.Read().end());
+    }
+
+    return burst;
+}
+
+//! Send a burst without timing it.
+void SendBurst(benchmark::State& state,
+               net::TcpSocket<net::Ipv4Addr>& sender,
+               const std::span<const std::byte> burst) {
+    state.PauseTiming();
+    for (auto data{ burst }; !data.empty();) {
+        data = data.subspan(sender.Send(data));
+    }
+
+    state.ResumeTiming();
+}
+
+//! Report heap allocations per received packet since a count.
+void ReportBurstAllocations(benchmark::State& state, const std::size_t begin) {
+    state.counters["allocs_per_packet"] =
+        static_cast<double>(bench::Allocations() - begin)
+        / static_cast<double>(state.iterations() * recv_burst);
+    state.SetItemsProcessed(state.iterations()
+                            * static_cast<std::int64_t>(recv_burst));
+}
+
+void BM_PacketRecv(benchmark::State& state) {
+    const auto body_size{ static_cast<std::size_t>(state.range(0)) };
+    auto [sender, receiver]{ bench::SocketPair() };
+    const auto burst{ MakeBurst(body_size) };
+
+    benchmark::DoNotOptimize(bench::MakePacket(body_size));
+
+    const auto begin{ bench::Allocations() };
+    for (auto _ : state) {
+        SendBurst(state, sender, burst);
+        for (std::size_t i{ 0 }; i != recv_burst; ++i) {
+            benchmark::DoNotOptimize(net::Packet::Recv(receiver));
+        }
+    }
+
+    ReportBurstAllocations(state, begin);
+}
+
+void BM_ArenaRecv(benchmark::State& state) {
+    const auto body_size{ static_cast<std::size_t>(state.range(0)) };
+    auto [sender, receiver]{ bench::SocketPair() };
+    const auto burst{ MakeBurst(body_size) };
+
+    // Each frame is recycled once it has been read, as after processing.
+    net::RecvArena arena{};
+    const auto begin{ bench::Allocations() };
+    for (auto _ : state) {
+        SendBurst(state, sender, burst);
+        for (std::size_t i{ 0 }; i != recv_burst; ++i) {
+            const auto frame{ arena.Recv(receiver) };
+            benchmark::DoNotOptimize(frame.Read().data());
+        }
+    }
+
+    ReportBurstAllocations(state, begin);
+    state.counters["in_use"] = static_cast<double>(arena.InUse());
+}
+
+void BM_PacketRoundTrip(benchmark::State& state) {
+    const auto body_size{ static_cast<std::size_t>(state.range(0)) };
+    auto [client, server]{ bench::LoopbackPair() };
+    const std::vector<std::byte> body(body_size);
+
+    // Warm the pool up before counting.
+    benchmark::DoNotOptimize(bench::MakePacket(body_size));
+
+    const auto begin{ bench::Allocations() };
+    for (auto _ : state) {
+        net::Packet pkg{};
+        std::array<std::byte, sizeof(net::Header)> header{};
+        net::StoreHeader({ static_cast<std::uint32_t>(body_size) }, header);
+        pkg.Write(header);
+        pkg.Write(body);
+        pkg.Send(client);
+        benchmark::DoNotOptimize(net::Packet::Recv(server));
+    }
+
+    ReportAllocations(state, begin);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SealVerify(benchmark::State& state) {
+    const auto body_size{ static_cast<std::size_t>(state.range(0)) };
+    const auto checksum{ state.range(1) != 0 };
+    std::vector<std::byte> packet(sizeof(net::Header) + body_size);
+
+    net::Header header{};
+    if (checksum) {
+        header.flags = static_cast<std::uint8_t>(net::HeaderFlag::Checksum);
+    }
+
+    for (auto _ : state) {
+        // A sealed header is in little-endian order and cannot be sealed again.
+        std::memcpy(packet.data(), &header, sizeof(header));
+        net::Seal(packet);
+        net::Verify(packet);
+        benchmark::DoNotOptimize(packet.data());
+    }
+
+    state.counters["hardware_crc"] = net::HardwareCrc32c() ? 1 : 0;
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<std::int64_t>(packet.size()));
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_PacketWriteRead)->ArgName("body_size")->Arg(20)->Arg(4096);
+BENCHMARK(BM_PacketRecv)->ArgName("body_size")->Arg(20)->Arg(4096);
+BENCHMARK(BM_ArenaRecv)->ArgName("body_size")->Arg(20)->Arg(4096);
+BENCHMARK(BM_PacketRoundTrip)->ArgName("body_size")->Arg(20)->Arg(4096);
+BENCHMARK(BM_SealVerify)
+    ->ArgNames({ "body_size", "checksum" })
+    ->ArgsProduct({ { 16, 4096 }, { 0, 1 } });
@@ -0,0 +1,303 @@
+/**
+ * @file reliable.cpp
+ * @brief Benchmarks of the reliability layer over UDP under simulated loss.
+ *
+ * @details
+ * Each iteration sends a burst of unordered creation events and an ordered level-end event
+ * over the loop-back address, and waits until all of them are delivered.
+ * Loss is injected on both ends, so data and acknowledgements are dropped.
+ *
+ * A lossy in-memory link also checks the delivery guarantees with a simulated clock.
+ * Datagrams are dropped and reordered, and sequence numbers start just below the wraparound.
+ * The benchmark fails if a message is lost, duplicated or delivered before an earlier message it must wait for.
+ */
+
+#include "common.h"
+
+#include "network/reactor.h"
+#include "network/reliable.h"
+#include "network/socket/udp.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+
+namespace {
+
+using namespace std::chrono_literals;
+
+//! The body size of a creation event.
+constexpr std::size_t event_size{ 20 };
+
+//! The number of unordered events in a burst.
+constexpr std::size_t burst_size{ 8 };
+
+//! The maximum time to deliver a burst.
+constexpr auto burst_timeout{ 1s };
+
+//! The number of messages sent over the lossy in-memory link.
+constexpr std::uint32_t link_msgs{ 2000 };
+
+//! One in this number of messages sent over the lossy in-memory link is ordered.
+constexpr std::uint32_t ordered_odds{ 10 };
+
+using bench::Clock;
+using UdpSocket = net::UdpSocket<net::Ipv4Addr>;
+
+//! Create a UDP socket bound to an ephemeral loop-back port.
+UdpSocket BindLoopback() {
+    UdpSocket socket{};
+    socket.SetAddr(net::Ipv4Addr{ "127.0.0.1", 0 });
+    socket.Bind();
+    return socket;
+}
+
+void BM_ReliableBurst(benchmark::State& state) {
+    const auto loss_rate{ static_cast<double>(state.range(0)) / 100 };
+
+    auto client{ BindLoopback() };
+    auto server{ BindLoopback() };
+    client.Connect(server.LocalAddr());
+    server.Connect(client.LocalAddr());
+
+    // The first byte of a message tells its delivery,
+    // and ordered messages carry an increasing number.
+    std::size_t delivered{ 0 };
+    std::uint32_t last_ordered{ 0 };
+    bool out_of_order{ false };
+    const auto on_deliver{ [&](const std::span<const std::byte> msg) {
+        ++delivered;
+        if (msg.front() == std::byte{ 1 }) {
+            std::uint32_t num{ 0 };
+            std::memcpy(&num, msg.data() + 1, sizeof(num));
+            out_of_order |= num != last_ordered + 1;
+            last_ordered = num;
+        }
+    } };
+
+    net::ReliableOptions options{ .resend_timeout{ 2ms },
+                                  .max_transmissions{ 100 },
+                                  .loss_rate{ loss_rate },
+                                  .loss_seed{ 1 } };
+    net::ReliableChannel sender{
+        [&client](const auto datagram) { client.Send(datagram); },
+        [](auto) {}, options
+    };
+
+    options.loss_seed = 2;
+    net::ReliableChannel receiver{
+        [&server](const auto datagram) { server.Send(datagram); }, on_deliver,
+        options
+    };
+
+    net::Reactor reactor{};
+    std::array<std::byte, net::ReliableChannel::max_msg_size * 2> buffer{};
+    const auto watch{ [&](const UdpSocket& socket,
+                          net::ReliableChannel& channel) {
+        reactor.Watch(socket.ID(), net::Event::Read, [&](net::Event) {
+            const auto size{ socket.Recv(buffer) };
+            channel.Receive(std::span{ buffer }.first(size));
+        });
+    } };
+
+    watch(client, sender);
+    watch(server, receiver);
+
+    // Wait for events until the next resend or acknowledgement is due.
+    const auto pump{ [&] {
+        Clock::duration timeout{ 1ms };
+        for (const auto* channel : { &sender, &receiver }) {
+            if (const auto deadline{ channel->NextDeadline() }) {
+                timeout = std::clamp(deadline.value() - Clock::now(),
+                                     Clock::duration::zero(), timeout);
+            }
+        }
+
+        reactor.RunOnce(timeout);
+        const auto now{ Clock::now() };
+        sender.Poll(now);
+        receiver.Poll(now);
+    } };
+
+    std::array<std::byte, event_size> event{};
+    std::uint32_t ordered{ 0 };
+    bench::LatencyRecorder recorder{};
+    std::size_t msgs{ 0 };
+    for (auto _ : state) {
+        recorder.Start();
+        const auto begin{ Clock::now() };
+        delivered = 0;
+        event.front() = std::byte{ 0 };
+        for (std::size_t i{ 0 }; i != burst_size; ++i) {
+            sender.Send(event, net::Delivery::Unordered, begin);
+        }
+
+        ++ordered;
+        event.front() = std::byte{ 1 };
+        std::memcpy(event.data() + 1, &ordered, sizeof(ordered));
+        sender.Send(event, net::Delivery::Ordered, begin);
+        msgs += burst_size + 1;
+
+        while (delivered != burst_size + 1) {
+            if (Clock::now() - begin > burst_timeout) {
+                state.SkipWithError("The burst has not been delivered.");
+                return;
+            }
+
+            pump();
+        }
+
+        recorder.Stop();
+
+        // Let the sender see all acknowledgements before the next burst.
+        while (sender.Unacknowledged() != 0) {
+            pump();
+        }
+    }
+
+    if (out_of_order) {
+        state.SkipWithError("Ordered events have been delivered out of order.");
+        return;
+    }
+
+    const auto& stats{ sender.Stats() };
+    state.counters["resends_per_msg"]
+        = static_cast<double>(stats.resent) / static_cast<double>(msgs);
+    state.counters["duplicates"]
+        = static_cast<double>(receiver.Stats().duplicates);
+    state.SetItemsProcessed(static_cast<std::int64_t>(msgs));
+    recorder.Report(state);
+}
+
+//! A lossy one-way link delivering the datagrams of each step in a random order.
+class LossyLink {
+public:
+    explicit LossyLink(const std::uint32_t seed) noexcept : rand_{ seed } {}
+
+    void Push(const std::span<const std::byte> datagram) {
+        datagrams_.emplace_back(datagram.begin(), datagram.end());
+    }
+
+    void Deliver(net::ReliableChannel& channel) {
+        auto datagrams{ std::move(datagrams_) };
+        datagrams_.clear();
+        std::ranges::shuffle(datagrams, rand_);
+        for (const auto& datagram : datagrams) {
+            channel.Receive(datagram);
+        }
+    }
+
+private:
+    std::minstd_rand rand_;
+
+    std::vector<std::vector<std::byte>> datagrams_{};
+};
+
+void BM_ReliableLossyLink(benchmark::State& state) {
+    const auto loss_rate{ static_cast<double>(state.range(0)) / 100 };
+
+    std::size_t resent{ 0 };
+    for (auto _ : state) {
+        LossyLink to_receiver{ 1 };
+        LossyLink to_sender{ 2 };
+
+        // A message carries its index, and all messages before an ordered one must have been delivered.
+        std::vector<bool> delivered(link_msgs, false);
+        std::uint32_t prefix{ 0 };
+        const char* error{ nullptr };
+        const auto on_deliver{ [&](const std::span<const std::byte> msg) {
+            std::uint32_t index{ 0 };
+            std::memcpy(&index, msg.data(), sizeof(index));
+            if (delivered[index]) {
+                error = "A message has been delivered more than once.";
+            } else if (msg.size() > sizeof(index) && prefix != index) {
+                error = "An ordered message has overtaken an earlier one.";
+            }
+
+            delivered[index] = true;
+            while (prefix != link_msgs && delivered[prefix]) {
+                ++prefix;
+            }
+        } };
+
+        net::ReliableOptions options{
+            .resend_timeout{ 5ms },
+            .max_transmissions{ 100 },
+            .loss_rate{ loss_rate },
+            .loss_seed{ 1 },
+            .initial_seq{ std::numeric_limits<std::uint32_t>::max()
+                          - link_msgs / 2 }
+        };
+        net::ReliableChannel sender{
+            [&](const auto datagram) { to_receiver.Push(datagram); },
+            [](auto) {}, options
+        };
+
+        options.loss_seed = 2;
+        net::ReliableChannel receiver{
+            [&](const auto datagram) { to_sender.Push(datagram); },
+            on_deliver, options
+        };
+
+        Clock::time_point now{};
+        for (std::uint32_t index{ 0 }; index != link_msgs; ++index) {
+            // An ordered message has an extra byte.
+            std::array<std::byte, sizeof(index) + 1> msg{};
+            std::memcpy(msg.data(), &index, sizeof(index));
+            const auto ordered{ index % ordered_odds == ordered_odds - 1 };
+            sender.Send(ordered ? std::span{ msg }
+                                : std::span{ msg }.first(sizeof(index)),
+                        ordered ? net::Delivery::Ordered
+                                : net::Delivery::Unordered,
+                        now);
+            to_receiver.Deliver(receiver);
+            to_sender.Deliver(sender);
+            now += 1ms;
+            sender.Poll(now);
+            receiver.Poll(now);
+        }
+
+        while (sender.Unacknowledged() != 0) {
+            to_receiver.Deliver(receiver);
+            to_sender.Deliver(sender);
+            now += 1ms;
+            sender.Poll(now);
+            receiver.Poll(now);
+        }
+
+        if (error == nullptr && prefix != link_msgs) {
+            error = "A message has been lost.";
+        }
+
+        if (error != nullptr) {
+            state.SkipWithError(error);
+            return;
+        }
+
+        resent += sender.Stats().resent;
+    }
+
+    state.counters["resends_per_msg"] = static_cast<double>(resent)
+                                        / static_cast<double>(state.iterations())
+                                        / link_msgs;
+    state.SetItemsProcessed(state.iterations() * link_msgs);
+}
+
+}  // namespace
+
+BENCHMARK(BM_ReliableBurst)
+    ->ArgName("loss_pct")
+    ->Arg(0)
+    ->Arg(10)
+    ->Arg(30)
+    ->UseRealTime();
+BENCHMARK(BM_ReliableLossyLink)->ArgName("loss_pct")->Arg(0)->Arg(10)->Arg(30);
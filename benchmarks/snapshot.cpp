@@ -0,0 +1,111 @@
+/**
+ * @file snapshot.cpp
+ * @brief Benchmarks of state snapshots.
+ *
+ * @details
+ * The level state is replaced by synthetic arrays of records of the same size as @p PlantedPlant,
+ * with the amount of sun and the numbers of plants and zombies.
+ * A snapshot is saved each tick, and the latest one is restored.
+ */
+
+#include "common.h"
+
+#include "netpkg/snapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+
+namespace {
+
+using namespace game;
+
+//! The size of @p PlantedPlant in the game.
+constexpr std::size_t planted_plant_size{ 0x14C };
+
+//! The number of snapshots kept, which covers 640 milliseconds of 10-millisecond ticks.
+constexpr std::size_t ring_depth{ 64 };
+
+//! A synthetic level state.
+struct Level {
+    explicit Level(const std::size_t plant_num) :
+        plants(plant_num * planted_plant_size) {
+        for (std::size_t i{ 0 }; i != plants.size(); ++i) {
+            plants[i] = static_cast<std::byte>(i);
+        }
+    }
+
+    //! Get the size of a snapshot.
+    std::size_t Size() const noexcept {
+        return sizeof(sun) + sizeof(zombie_num) + sizeof(plant_num)
+               + plants.size();
+    }
+
+    std::int32_t sun{ 50 };
+    std::int32_t zombie_num{ 0 };
+    std::int32_t plant_num{ 0 };
+    std::vector<std::byte> plants;
+};
+
+void Save(netpkg::SnapshotRing& ring, const netpkg::Tick tick,
+          const Level& level) {
+    ring.Save(tick, { bench::AsBytes(level.sun),
+                      bench::AsBytes(level.zombie_num),
+                      bench::AsBytes(level.plant_num), level.plants });
+}
+
+void BM_SnapshotSave(benchmark::State& state) {
+    const Level level{ static_cast<std::size_t>(state.range(0)) };
+    netpkg::SnapshotRing ring{ ring_depth, level.Size() };
+
+    const auto begin{ bench::Allocations() };
+    netpkg::Tick tick{ 0 };
+    for (auto _ : state) {
+        Save(ring, tick++, level);
+    }
+
+    state.counters["allocs_per_snapshot"] =
+        static_cast<double>(bench::Allocations() - begin)
+        / static_cast<double>(state.iterations());
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<std::int64_t>(level.Size()));
+}
+
+void BM_SnapshotRestore(benchmark::State& state) {
+    Level level{ static_cast<std::size_t>(state.range(0)) };
+    netpkg::SnapshotRing ring{ ring_depth, level.Size() };
+
+    // Each iteration restores the state before a tick and saves it again, as running the tick again would.
+    netpkg::Tick tick{ 0 };
+    Save(ring, tick, level);
+    const auto begin{ bench::Allocations() };
+    for (auto _ : state) {
+        auto snapshot{ ring.Rewind(tick).value() };
+        std::memcpy(&level.sun, snapshot.data(), sizeof(level.sun));
+        snapshot = snapshot.subspan(sizeof(level.sun));
+        std::memcpy(&level.zombie_num, snapshot.data(),
+                    sizeof(level.zombie_num));
+        snapshot = snapshot.subspan(sizeof(level.zombie_num));
+        std::memcpy(&level.plant_num, snapshot.data(),
+                    sizeof(level.plant_num));
+        snapshot = snapshot.subspan(sizeof(level.plant_num));
+        std::memcpy(level.plants.data(), snapshot.data(), snapshot.size());
+        Save(ring, tick, level);
+    }
+
+    benchmark::DoNotOptimize(level.plants.data());
+    state.counters["allocs_per_snapshot"] =
+        static_cast<double>(bench::Allocations() - begin)
+        / static_cast<double>(state.iterations());
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<std::int64_t>(level.Size()));
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_SnapshotSave)->ArgName("plants")->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(BM_SnapshotRestore)->ArgName("plants")->Arg(64)->Arg(256)->Arg(1024);
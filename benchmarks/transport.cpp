@@ -0,0 +1,150 @@
+/**
+ * @file transport.cpp
+ * @brief Benchmarks of the blocking, vectored, buffered and io_uring transports.
+ *
+ * @details
+ * Each iteration sends a frame of packets over the loop-back address and receives them.
+ * System calls per packet and latency percentiles of frames are reported as counters.
+ */
+
+#include "common.h"
+
+#include "network/packet.h"
+#include "network/socket/uring.h"
+#include "network/stream_reader.h"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+
+namespace {
+
+//! The body size of a creation event.
+constexpr std::size_t body_size{ 20 };
+
+void ReportSyscalls(benchmark::State& state, const std::size_t calls) {
+    const auto packets{ state.iterations() * state.range(0) };
+    state.counters["syscalls_per_packet"] =
+        static_cast<double>(calls) / static_cast<double>(packets);
+    state.SetItemsProcessed(packets);
+}
+
+
+void BM_BlockingTransport(benchmark::State& state) {
+    auto [client, server]{ bench::LoopbackPair() };
+    bench::CountingSocket sender{ client };
+    bench::CountingSocket receiver{ server };
+    auto pkg{ bench::MakePacket(body_size) };
+
+    bench::LatencyRecorder latency{};
+    for (auto _ : state) {
+        latency.Start();
+        for (auto i{ 0 }; i != state.range(0); ++i) {
+            pkg.Send(sender);
+        }
+
+        for (auto i{ 0 }; i != state.range(0); ++i) {
+            benchmark::DoNotOptimize(net::Packet::Recv(receiver));
+        }
+
+        latency.Stop();
+    }
+
+    latency.Report(state);
+    ReportSyscalls(state, sender.Calls() + receiver.Calls());
+}
+
+void BM_VectoredTransport(benchmark::State& state) {
+    auto [client, server]{ bench::LoopbackPair() };
+    bench::CountingSocket sender{ client };
+    bench::CountingSocket receiver{ server };
+
+    // The header and body are sent from separate buffers without copying.
+    const std::array<std::byte, body_size> body{};
+    const std::array<std::span<const std::byte>, 1> payload{ body };
+
+    bench::LatencyRecorder latency{};
+    for (auto _ : state) {
+        latency.Start();
+        for (auto i{ 0 }; i != state.range(0); ++i) {
+            net::Header header{};
+            net::Packet::Send(sender, header, payload);
+        }
+
+        for (auto i{ 0 }; i != state.range(0); ++i) {
+            benchmark::DoNotOptimize(net::Packet::Recv(receiver));
+        }
+
+        latency.Stop();
+    }
+
+    latency.Report(state);
+    ReportSyscalls(state, sender.Calls() + receiver.Calls());
+}
+
+void BM_BufferedTransport(benchmark::State& state) {
+    auto [client, server]{ bench::LoopbackPair() };
+    bench::CountingSocket sender{ client };
+    bench::CountingSocket receiver{ server };
+    net::StreamReader reader{ receiver };
+    auto pkg{ bench::MakePacket(body_size) };
+
+    bench::LatencyRecorder latency{};
+    for (auto _ : state) {
+        latency.Start();
+        for (auto i{ 0 }; i != state.range(0); ++i) {
+            pkg.Send(sender);
+        }
+
+        // A burst of packets is received with as few calls as the kernel allows.
+        for (auto i{ 0 }; i != state.range(0);) {
+            if (const auto frame{ reader.Next() }) {
+                benchmark::DoNotOptimize(frame->data());
+                ++i;
+            } else {
+                reader.Fill();
+            }
+        }
+
+        latency.Stop();
+    }
+
+    latency.Report(state);
+    ReportSyscalls(state, sender.Calls() + receiver.Calls());
+}
+
+void BM_UringTransport(benchmark::State& state) {
+    auto [client, server]{ bench::LoopbackPair() };
+    net::UringSocket sender{ std::move(client) };
+    net::UringSocket receiver{ std::move(server) };
+    auto pkg{ bench::MakePacket(body_size) };
+
+    const auto setup_calls{ sender.Stats().enters + receiver.Stats().enters };
+    bench::LatencyRecorder latency{};
+    for (auto _ : state) {
+        latency.Start();
+        for (auto i{ 0 }; i != state.range(0); ++i) {
+            pkg.Send(sender);
+        }
+
+        sender.Flush();
+        for (auto i{ 0 }; i != state.range(0); ++i) {
+            benchmark::DoNotOptimize(net::Packet::Recv(receiver));
+        }
+
+        latency.Stop();
+    }
+
+    latency.Report(state);
+    ReportSyscalls(state, sender.Stats().enters + receiver.Stats().enters
+                              - setup_calls);
+}
+
+}  // namespace
+
+
+BENCHMARK(BM_BlockingTransport)->Arg(1)->Arg(8)->Arg(32);
+BENCHMARK(BM_VectoredTransport)->Arg(1)->Arg(8)->Arg(32);
+BENCHMARK(BM_BufferedTransport)->Arg(1)->Arg(8)->Arg(32);
+BENCHMARK(BM_UringTransport)->Arg(1)->Arg(8)->Arg(32);
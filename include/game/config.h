@@ -17,6 +17,7 @@
 #include "network/ip_addr.h"
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <map>
@@ -58,30 +59,41 @@ private:
     Slots plants_{ default_plants };
 };
 
-//! Build IPv4 or IPv6.
-#ifdef INET6
-using IpAddr = net::Ipv6Addr;
-#else
-using IpAddr = net::Ipv4Addr;
-#endif  // INET6
+//! The IP address, whose version is chosen at runtime.
+using IpAddr = net::SockAddr;
 
 //! Network-related configurations.
 class Network final {
 public:
     //! The default server IP address.
-#ifdef INET6
-    static constexpr std::string_view default_server_ip{
-        net::Ipv6Addr::loop_back
-    };
-#else
     static constexpr std::string_view default_server_ip{
         net::Ipv4Addr::loop_back
     };
-#endif  // INET6
 
     //! The default port number.
     static constexpr std::uint16_t default_port{ 10000 };
 
+    //! The default name of the latency profile.
+    static constexpr std::string_view default_profile{ "LowLatency" };
+
+    //! The default maximum time to connect to the server.
+    static constexpr std::chrono::milliseconds default_connect_timeout{ 3000 };
+
+    //! The default maximum time an outbound event waits to be sent with others.
+    static constexpr std::chrono::microseconds default_batch_delay{ 2000 };
+
+    //! Whether to offer the compact encoding of packets by default.
+    static constexpr bool default_compact_encoding{ true };
+
+    //! Whether to add checksums to packets by default, which disables the compact encoding.
+    static constexpr bool default_checksum{ false };
+
+    //! The default time between creating an item and applying it on both sides.
+    static constexpr std::chrono::milliseconds default_input_delay{ 60 };
+
+    //! The default name of the policy for late events of the peer.
+    static constexpr std::string_view default_late_policy{ "Stall" };
+
     Network() noexcept;
 
     /**
@@ -91,12 +103,33 @@ public:
      */
     Network(std::string_view file) noexcept;
 
-    //! Get the server IP address.
+    //! Get the server host name or IP address.
     std::string_view ServerIp() const noexcept;
 
     //! Get the port number.
     std::uint16_t Port() const noexcept;
 
+    //! Get the name of the latency profile applied to the connection.
+    std::string_view Profile() const noexcept;
+
+    //! Get the maximum time to connect to the server.
+    std::chrono::milliseconds ConnectTimeout() const noexcept;
+
+    //! Get the maximum time an outbound event waits to be sent with others. Zero disables batching.
+    std::chrono::microseconds BatchDelay() const noexcept;
+
+    //! Check if the compact encoding of packets is offered to the peer.
+    bool CompactEncoding() const noexcept;
+
+    //! Check if checksums are added to packets, in which case the compact encoding is not offered.
+    bool Checksum() const noexcept;
+
+    //! Get the time between creating an item and applying it on both sides.
+    std::chrono::milliseconds InputDelay() const noexcept;
+
+    //! Get the name of the policy for late events of the peer.
+    std::string_view LatePolicy() const noexcept;
+
 private:
     //! The section name of network configurations in the @p .ini file.
     static constexpr std::string_view ini_section{ "Network" };
@@ -107,8 +140,40 @@ private:
     //! The key name of the port number in the @p .ini file.
     static constexpr std::string_view port_ini_key{ "Port" };
 
+    //! The key name of the latency profile in the @p .ini file.
+    static constexpr std::string_view profile_ini_key{ "LatencyProfile" };
+
+    //! The key name of the connecting timeout in milliseconds in the @p .ini file.
+    static constexpr std::string_view connect_timeout_ini_key{
+        "ConnectTimeout"
+    };
+
+    //! The key name of the batching delay in microseconds in the @p .ini file.
+    static constexpr std::string_view batch_delay_ini_key{ "BatchDelay" };
+
+    //! The key name of the compact encoding switch in the @p .ini file.
+    static constexpr std::string_view compact_encoding_ini_key{
+        "CompactEncoding"
+    };
+
+    //! The key name of the checksum switch in the @p .ini file.
+    static constexpr std::string_view checksum_ini_key{ "Checksum" };
+
+    //! The key name of the input delay in milliseconds in the @p .ini file.
+    static constexpr std::string_view input_delay_ini_key{ "InputDelay" };
+
+    //! The key name of the late policy in the @p .ini file.
+    static constexpr std::string_view late_policy_ini_key{ "LatePolicy" };
+
     std::string server_ip_{ default_server_ip };
     std::uint16_t port_{ default_port };
+    std::string profile_{ default_profile };
+    std::chrono::milliseconds connect_timeout_{ default_connect_timeout };
+    std::chrono::microseconds batch_delay_{ default_batch_delay };
+    bool compact_encoding_{ default_compact_encoding };
+    bool checksum_{ default_checksum };
+    std::chrono::milliseconds input_delay_{ default_input_delay };
+    std::string late_policy_{ default_late_policy };
 };
 
 }  // namespace cfg
@@ -32,10 +32,22 @@ public:
 
     ~Startup() noexcept;
 
-    //! Initialize the game.
+    /**
+     * @brief Initialize the game.
+     *
+     * @details The module is pinned, so it is never unloaded before the process exits.
+     *
+     * @exception std::system_error The module cannot be pinned.
+     */
     void Run();
 
-    //! Release resources.
+    /**
+     * @brief Release resources when the process exits.
+     *
+     * @details
+     * It runs under the loader lock, so it neither stops nor waits for threads.
+     * Network threads are stopped on the game thread before each level and when a level ends.
+     */
     void Stop() noexcept;
 };
 
@@ -0,0 +1,32 @@
+/**
+ * @file dictionary.h
+ * @brief The compression dictionary of packets.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+
+namespace game::netpkg {
+
+/**
+ * @brief Get the dictionary for compressing streams of packets in the fixed layout.
+ *
+ * @details
+ * It is trained once from creation events of every default slot in every lane, level-end packets and heartbeats,
+ * so both sides of a stream get the same dictionary.
+ */
+std::span<const std::byte> CompressionDictionary();
+
+}  // namespace game::netpkg
@@ -0,0 +1,234 @@
+/**
+ * @file dispatch.h
+ * @brief The table-driven dispatch of received packets.
+ *
+ * @details
+ * Handlers are registered against message types at compile time,
+ * and a dense jump table indexed by type tags is built from them as a constant.
+ * Dispatching a packet is a bounds check and an indirect call.
+ * Packets of unknown types or of too small sizes are counted and skipped without exceptions.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "message.h"
+
+#include "network/packet_view.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+
+namespace game::netpkg {
+
+/**
+ * @brief A handler of a message.
+ *
+ * @tparam MESSAGE A message schema.
+ * @tparam HANDLE A function called with a context and a copy of the message in the fixed layout.
+ */
+template <typename MESSAGE, auto HANDLE>
+struct Handler {
+    using Message = MESSAGE;
+
+    static constexpr auto handle{ HANDLE };
+};
+
+/**
+ * @brief The dispatcher of received packets.
+ *
+ * @tparam CONTEXT The context passed to handlers.
+ * @tparam HANDLERS @p Handler types with unique message types.
+ */
+template <typename CONTEXT, typename... HANDLERS>
+class Dispatcher final {
+public:
+    //! The size of the jump table, which covers type tags up to the largest one.
+    static constexpr std::size_t table_size{
+        std::max({ static_cast<std::size_t>(HANDLERS::Message::type)... }) + 1
+    };
+
+    static_assert(sizeof...(HANDLERS) != 0);
+    static_assert(
+        [] {
+            std::array<bool, table_size> registered{};
+            for (const auto type : { HANDLERS::Message::type... }) {
+                if (std::exchange(
+                        registered[static_cast<std::size_t>(type)], true)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }(),
+        "Message types must be unique.");
+    static_assert(
+        (std::is_invocable_v<decltype(HANDLERS::handle), CONTEXT&,
+                             const typename HANDLERS::Message::Layout&>
+         && ...),
+        "A handler must accept a context and a message.");
+
+    /**
+     * @brief Create a dispatcher.
+     *
+     * @param context A context. It must outlive the dispatcher.
+     */
+    explicit Dispatcher(CONTEXT& context) noexcept : context_{ context } {}
+
+    /**
+     * @brief Dispatch a packet to its handler.
+     *
+     * @param packet A packet including its header, in a buffer of any alignment.
+     * @return Whether the packet has been handled.
+     * Packets of unknown types or smaller than their messages are counted and skipped.
+     */
+    bool Dispatch(const std::span<const std::byte> packet) {
+        const auto header{ net::PacketView<net::Header>::From(packet) };
+        if (!header.has_value()) {
+            ++malformed_;
+            return false;
+        }
+
+        const auto type{ header->Get(&net::Header::type) };
+        const auto entry{ type < table.size() ? table[type] : nullptr };
+        if (entry == nullptr) {
+            ++unknown_;
+            return false;
+        } else if (!entry(context_, packet)) {
+            ++malformed_;
+            return false;
+        }
+
+        ++handled_;
+        return true;
+    }
+
+    //! Get the number of handled packets.
+    std::uint64_t Handled() const noexcept {
+        return handled_;
+    }
+
+    //! Get the number of skipped packets of unknown types.
+    std::uint64_t Unknown() const noexcept {
+        return unknown_;
+    }
+
+    //! Get the number of skipped packets that are too small.
+    std::uint64_t Malformed() const noexcept {
+        return malformed_;
+    }
+
+private:
+    //! An entry of the jump table, which returns @p false if the packet is too small.
+    using Entry = bool (*)(CONTEXT&, std::span<const std::byte>);
+
+    //! Load a message and call its handler.
+    template <typename HANDLER>
+    static bool Invoke(CONTEXT& context,
+                       const std::span<const std::byte> packet) {
+        using Layout = typename HANDLER::Message::Layout;
+        const auto msg{ net::PacketView<Layout>::From(packet) };
+        if (!msg.has_value()) {
+            return false;
+        }
+
+        std::invoke(HANDLER::handle, context, msg->Load());
+        return true;
+    }
+
+    //! The jump table indexed by type tags, where unregistered types are empty.
+    static constexpr std::array<Entry, table_size> table{ [] {
+        std::array<Entry, table_size> entries{};
+        ((entries[static_cast<std::size_t>(HANDLERS::Message::type)]
+          = &Invoke<HANDLERS>),
+         ...);
+        return entries;
+    }() };
+
+    CONTEXT& context_;
+
+    std::uint64_t handled_{ 0 };
+
+    std::uint64_t unknown_{ 0 };
+
+    std::uint64_t malformed_{ 0 };
+};
+
+//! The game applying events at once.
+template <typename T>
+concept Backend
+    = requires(T& game, const std::int32_t pos_x, const std::int32_t pos_y,
+               const std::int32_t id) {
+          game.CreatePlant(pos_x, pos_y, id);
+          game.CreateZombie(pos_x, pos_y, id);
+          game.EndLevel();
+      };
+
+//! The receiver of events from the peer, which are stamped with ticks.
+template <typename T>
+concept Receiver
+    = requires(T& receiver, const std::int32_t pos_x, const std::int32_t pos_y,
+               const std::int32_t id, const Tick tick) {
+          receiver.CreatePlant(pos_x, pos_y, id, tick);
+          receiver.CreateZombie(pos_x, pos_y, id, tick);
+          receiver.Confirm(tick);
+          receiver.EndLevel();
+      };
+
+namespace detail {
+
+template <Receiver RECEIVER>
+void CreatePlant(RECEIVER& receiver, const NewItem& item) {
+    receiver.CreatePlant(item.pos_x, item.pos_y, item.id, item.tick);
+}
+
+template <Receiver RECEIVER>
+void CreateZombie(RECEIVER& receiver, const NewItem& item) {
+    receiver.CreateZombie(item.pos_x, item.pos_y, item.id, item.tick);
+}
+
+template <Receiver RECEIVER>
+void Confirm(RECEIVER& receiver, const Heartbeat& heartbeat) {
+    receiver.Confirm(heartbeat.tick);
+}
+
+template <Receiver RECEIVER>
+void EndLevel(RECEIVER& receiver, const Header&) {
+    receiver.EndLevel();
+}
+
+}  // namespace detail
+
+/**
+ * @brief The dispatcher of game events.
+ *
+ * @details
+ * @p Hello packets are only expected in the handshake, so they are skipped as unknown.
+ *
+ * @tparam RECEIVER The receiver of events, or a stub of it.
+ */
+template <Receiver RECEIVER>
+using EventDispatcher
+    = Dispatcher<RECEIVER,
+                 Handler<NewPlantMessage, &detail::CreatePlant<RECEIVER>>,
+                 Handler<NewZombieMessage, &detail::CreateZombie<RECEIVER>>,
+                 Handler<LevelEndMessage, &detail::EndLevel<RECEIVER>>,
+                 Handler<HeartbeatMessage, &detail::Confirm<RECEIVER>>>;
+
+}  // namespace game::netpkg
@@ -0,0 +1,196 @@
+/**
+ * @file inbound.h
+ * @brief The inbound queue of game events.
+ *
+ * @details
+ * The receiver thread must not change game memory while the game thread is running.
+ * Instead, it dispatches packets into the queue as decoded events,
+ * and the game thread drains the queue when it updates, passing each event to the lockstep scheduler.
+ * The queue records its depth and how long events wait before the game thread takes them.
+ * Every event matters to both boards, so none is ever dropped:
+ * the receiver thread stops reading while the queue is full.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "dispatch.h"
+#include "layout.h"
+
+#include "network/spsc_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace game::netpkg {
+
+//! A game event received from the peer.
+struct Event {
+    using Clock = std::chrono::steady_clock;
+
+    //! The type of the packet carrying the event.
+    Type type;
+
+    //! The tick at which the event is applied, or the confirmed tick of a heartbeat.
+    Tick tick{ 0 };
+
+    std::int32_t pos_x{ 0 };
+
+    std::int32_t pos_y{ 0 };
+
+    std::int32_t id{ 0 };
+
+    //! The time it was received.
+    Clock::time_point received{};
+};
+
+//! Statistics of an inbound queue.
+struct InboundStats {
+    //! The maximum number of events waiting at once.
+    std::size_t max_depth{ 0 };
+
+    //! The number of events taken by the game thread.
+    std::uint64_t applied{ 0 };
+
+    //! The total time taken events waited.
+    Event::Clock::duration total_latency{ 0 };
+
+    //! The longest time a taken event waited.
+    Event::Clock::duration max_latency{ 0 };
+};
+
+/**
+ * @brief The inbound queue of game events.
+ *
+ * @details
+ * It is a receiver of @p EventDispatcher on the receiver thread,
+ * and passes events to another receiver on the game thread.
+ * The receiver thread must check @p Full before dispatching each packet,
+ * and wait for the game thread if the queue is full.
+ */
+class InboundQueue final {
+public:
+    //! The maximum number of waiting events, which is far more than a player can create between two updates.
+    static constexpr std::size_t capacity{ 1024 };
+
+    InboundQueue() noexcept = default;
+
+    InboundQueue(const InboundQueue&) = delete;
+
+    InboundQueue& operator=(const InboundQueue&) = delete;
+
+    /**
+     * @brief Queue a plant creation on the receiver thread.
+     *
+     * @exception std::length_error The queue is full.
+     */
+    void CreatePlant(std::int32_t pos_x, std::int32_t pos_y, std::int32_t id,
+                     Tick tick);
+
+    /**
+     * @brief Queue a zombie creation on the receiver thread.
+     *
+     * @exception std::length_error The queue is full.
+     */
+    void CreateZombie(std::int32_t pos_x, std::int32_t pos_y, std::int32_t id,
+                      Tick tick);
+
+    /**
+     * @brief Queue a heartbeat on the receiver thread.
+     *
+     * @exception std::length_error The queue is full.
+     */
+    void Confirm(Tick tick);
+
+    /**
+     * @brief Queue the end of a level on the receiver thread.
+     *
+     * @exception std::length_error The queue is full.
+     */
+    void EndLevel();
+
+    /**
+     * @brief Pass waiting events to a receiver on the game thread.
+     *
+     * @tparam RECEIVER The lockstep scheduler, or a stub of it.
+     * @param receiver A receiver.
+     * @return The number of passed events.
+     */
+    template <Receiver RECEIVER>
+    std::size_t Drain(RECEIVER& receiver) {
+        const auto now{ Event::Clock::now() };
+        std::size_t count{ 0 };
+        while (const auto event{ events_.TryPop() }) {
+            // Events are counted before they are passed, in case the receiver throws.
+            ++count;
+            ++stats_.applied;
+            const auto latency{ now - event->received };
+            stats_.total_latency += latency;
+            if (latency > stats_.max_latency) {
+                stats_.max_latency = latency;
+            }
+
+            if (event->type == Type::NewPlant) {
+                receiver.CreatePlant(event->pos_x, event->pos_y, event->id,
+                                     event->tick);
+            } else if (event->type == Type::NewZombie) {
+                receiver.CreateZombie(event->pos_x, event->pos_y, event->id,
+                                      event->tick);
+            } else if (event->type == Type::Heartbeat) {
+                receiver.Confirm(event->tick);
+            } else {
+                receiver.EndLevel();
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Discard waiting events and reset statistics on the game thread while the receiver thread is stopped.
+     *
+     * @return The number of discarded events.
+     */
+    std::size_t Clear() noexcept;
+
+    //! Get the number of waiting events, which may be outdated when it returns.
+    std::size_t Depth() const noexcept;
+
+    //! Check on the receiver thread whether no event can be queued until the game thread takes some.
+    bool Full() const noexcept;
+
+    //! Get the maximum number of events waiting at once on any thread.
+    std::size_t MaxDepth() const noexcept;
+
+    //! Get statistics on the game thread.
+    InboundStats Stats() const noexcept;
+
+private:
+    /**
+     * @brief Queue an event on the receiver thread.
+     *
+     * @exception std::length_error The queue is full.
+     */
+    void Push(const Event& event);
+
+    net::SpscQueue<Event, capacity> events_{};
+
+    //! Statistics written by the game thread.
+    InboundStats stats_{};
+
+    //! The maximum depth, written by the receiver thread.
+    std::atomic<std::size_t> max_depth_{ 0 };
+};
+
+}  // namespace game::netpkg
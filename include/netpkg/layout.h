@@ -0,0 +1,98 @@
+/**
+ * @file layout.h
+ * @brief The fixed layouts of network packets.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "game/config.h"
+
+#include "network/packet.h"
+#include "network/packet_view.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace game::netpkg {
+
+//! Types of packets, which are stored in @p net::Header::type.
+enum class Type : std::uint16_t {
+    NewPlant,
+    NewZombie,
+    LevelEnd,
+    Hello,
+    Heartbeat
+};
+
+//! A game tick of the lockstep timeline, counted from the start of a level.
+using Tick = std::uint32_t;
+
+//! Encodings of packets, which are negotiated by @p Hello packets.
+enum class Encoding : std::uint32_t {
+    //! Packet structures are sent as they are in memory.
+    Fixed = 1 << 0,
+
+    //! Packets are packed into a few bytes by @p CompactEncoder.
+    Compact = 1 << 1
+};
+
+//! The header of a packet.
+struct alignas(std::int32_t) Header : public net::Header {
+    //! The player's role.
+    Role role;
+};
+
+/**
+ * @brief Get the type of a packet.
+ *
+ * @param packet A packet including its header, in a buffer of any alignment.
+ * @return The type.
+ *
+ * @exception std::invalid_argument The packet is too small.
+ */
+inline Type TypeOf(const std::span<const std::byte> packet) {
+    return static_cast<Type>(
+        net::PacketView<Header>{ packet }.Get(&net::Header::type));
+}
+
+//! The packet storing a creation event.
+struct alignas(std::int32_t) NewItem : public Header {
+    //! The X-coordinate of the target location.
+    std::int32_t pos_x;
+
+    //! The Y-coordinate of the target location.
+    std::int32_t pos_y;
+
+    //! The item ID.
+    std::int32_t id;
+
+    //! The tick at which both sides apply the event.
+    Tick tick;
+};
+
+//! The first packet sent by each side, which always uses the fixed encoding.
+struct alignas(std::int32_t) Hello : public Header {
+    //! Supported encodings as a bit set of @p Encoding.
+    std::uint32_t encodings;
+
+    //! The input delay in ticks.
+    Tick input_delay;
+};
+
+//! The promise that later events of the sender are stamped with at least a tick.
+struct alignas(std::int32_t) Heartbeat : public Header {
+    Tick tick;
+};
+
+}  // namespace game::netpkg
@@ -0,0 +1,268 @@
+/**
+ * @file lockstep.h
+ * @brief The lockstep scheduler of game events.
+ *
+ * @details
+ * Without timing, an event is applied by the peer whenever it arrives,
+ * so the same item appears at different moments on the two boards.
+ * Instead, both sides run a timeline of fixed-length ticks from the start of a level.
+ * A local event is stamped with the tick due by the clock plus an input delay,
+ * and both sides apply it when their timelines reach that tick,
+ * with the plant side's events first if both sides have events in the same tick.
+ *
+ * Stamps of a side never decrease, and packets arrive in order,
+ * so a stamp promises that no earlier events will follow.
+ * A side without events sends heartbeats to keep promising.
+ * Stamps follow the clock rather than the timeline,
+ * so a stalled timeline falls behind by at most the latency beyond the input delay instead of slowing down both sides.
+ * An event arriving after its tick is handled by a @p LatePolicy.
+ *
+ * The scheduler takes the time as an argument, so it runs the same with a simulated clock.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "dispatch.h"
+#include "inbound.h"
+#include "message.h"
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string_view>
+
+
+namespace game::netpkg {
+
+//! Ways to handle events of the peer that arrive after their ticks.
+enum class LatePolicy {
+    //! A tick is not run until the peer has promised it no more events, so no events are late.
+    Stall,
+
+    //! Ticks follow the clock, and a late event is applied in the next tick.
+    Skip
+};
+
+/**
+ * @brief Get a late policy by its name.
+ *
+ * @param name @p Stall or @p Skip.
+ * @return The policy.
+ *
+ * @exception std::invalid_argument The name is unknown.
+ */
+LatePolicy LatePolicyFromName(std::string_view name);
+
+//! Options of a lockstep scheduler, which must be the same on both sides.
+struct LockstepOptions {
+    //! The default length of a tick.
+    static constexpr std::chrono::microseconds default_tick_interval{ 10000 };
+
+    //! The default number of ticks between creating and applying an event.
+    static constexpr Tick default_input_delay{ 6 };
+
+    //! The length of a tick.
+    std::chrono::microseconds tick_interval{ default_tick_interval };
+
+    //! The number of ticks between creating and applying an event, which should cover the network latency.
+    Tick input_delay{ default_input_delay };
+
+    LatePolicy policy{ LatePolicy::Stall };
+};
+
+//! Statistics of a lockstep scheduler.
+struct LockstepStats {
+    //! The number of applied local events.
+    std::uint64_t local{ 0 };
+
+    //! The number of applied events of the peer.
+    std::uint64_t remote{ 0 };
+
+    //! The number of events of the peer received after their ticks.
+    std::uint64_t late{ 0 };
+
+    //! The number of updates stopped by ticks the peer had not promised.
+    std::uint64_t stalls{ 0 };
+
+    //! The maximum number of ticks the timeline fell behind the clock.
+    Tick max_lag{ 0 };
+};
+
+/**
+ * @brief The lockstep scheduler of game events.
+ *
+ * @details
+ * It is a receiver of events from the peer and is only used on the game thread.
+ */
+class LockstepScheduler final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! Create a scheduler of the plant side with default options.
+    LockstepScheduler() noexcept;
+
+    /**
+     * @brief Create a scheduler.
+     *
+     * @param role The local player's role.
+     * @param options Options.
+     */
+    LockstepScheduler(Role role, const LockstepOptions& options) noexcept;
+
+    //! Receive a plant creation of the peer.
+    void CreatePlant(std::int32_t pos_x, std::int32_t pos_y, std::int32_t id,
+                     Tick tick);
+
+    //! Receive a zombie creation of the peer.
+    void CreateZombie(std::int32_t pos_x, std::int32_t pos_y, std::int32_t id,
+                      Tick tick);
+
+    //! Receive a heartbeat of the peer, or the largest tick if the peer has left and sends no more events.
+    void Confirm(Tick tick) noexcept;
+
+    //! Receive the end of the level from the peer, which is applied in the next update.
+    void EndLevel() noexcept;
+
+    /**
+     * @brief Get the tick at which a local event scheduled before the next update is applied.
+     *
+     * @details It lets an event be sent to the peer before it is scheduled.
+     */
+    Tick NextTick() const noexcept;
+
+    /**
+     * @brief Stamp a local event and queue it.
+     *
+     * @param event A creation event, whose tick is ignored.
+     * @return The tick at which both sides apply it, which is @p NextTick and must be sent to the peer.
+     */
+    Tick Schedule(Event event);
+
+    /**
+     * @brief Run ticks due by a time and apply their events.
+     *
+     * @details
+     * The timeline starts at the time of the first update.
+     *
+     * @tparam BACKEND The game, or a stub of it.
+     * @tparam SEND A function sending a heartbeat to the peer.
+     * @param now The current time.
+     * @param game A game.
+     * @param send A function called with a heartbeat if the peer needs one.
+     * @return The number of applied events.
+     */
+    template <Backend BACKEND, std::invocable<const Heartbeat&> SEND>
+    std::size_t Update(const Clock::time_point now, BACKEND& game,
+                       SEND send) {
+        const auto target{ Target(now) };
+        due_ = target;
+        std::size_t count{ 0 };
+        while (tick_ < target) {
+            if (options_.policy == LatePolicy::Stall && tick_ >= horizon_) {
+                ++stats_.stalls;
+                break;
+            }
+
+            while (const auto event{ NextDue() }) {
+                ++count;
+                if (event->type == Type::NewPlant) {
+                    game.CreatePlant(event->pos_x, event->pos_y, event->id);
+                } else {
+                    game.CreateZombie(event->pos_x, event->pos_y, event->id);
+                }
+            }
+
+            ++tick_;
+        }
+
+        if (target > tick_ && target - tick_ > stats_.max_lag) {
+            stats_.max_lag = target - tick_;
+        }
+
+        if (const auto heartbeat{ Promise() }) {
+            send(*heartbeat);
+        }
+
+        if (level_end_) {
+            level_end_ = false;
+            game.EndLevel();
+        }
+
+        return count;
+    }
+
+    //! Get the next tick to run.
+    Tick Current() const noexcept;
+
+    //! Get the tick before which the peer has sent all its events.
+    Tick Horizon() const noexcept;
+
+    //! Get the options.
+    const LockstepOptions& Options() const noexcept;
+
+    //! Get statistics.
+    const LockstepStats& Stats() const noexcept;
+
+private:
+    //! Get the tick at which a local event created now is applied, and promise no earlier events.
+    Tick Stamp() noexcept;
+
+    //! Get the number of ticks due by a time, starting the timeline if it has not started.
+    Tick Target(Clock::time_point now) noexcept;
+
+    //! Take the next event due in the current tick.
+    std::optional<Event> NextDue() noexcept;
+
+    //! Get a heartbeat if the peer has not been promised enough ticks.
+    std::optional<Heartbeat> Promise() noexcept;
+
+    //! Receive an event of the peer.
+    void Receive(const Event& event);
+
+    Role role_{ Role::Plant };
+
+    LockstepOptions options_{};
+
+    //! The number of ticks a promise can fall behind before a heartbeat is sent.
+    Tick heartbeat_interval_{ 1 };
+
+    //! The start of the timeline, or an empty value if it has not started.
+    std::optional<Clock::time_point> start_{};
+
+    //! The next tick to run.
+    Tick tick_{ 0 };
+
+    //! The number of ticks due by the clock at the last update, which never decreases.
+    Tick due_{ 0 };
+
+    //! The peer has sent all its events stamped before this tick.
+    Tick horizon_{ 0 };
+
+    //! All local events sent later are stamped with at least this tick.
+    Tick promised_{ 0 };
+
+    //! Local events waiting for their ticks.
+    std::deque<Event> local_{};
+
+    //! Events of the peer waiting for their ticks.
+    std::deque<Event> remote_{};
+
+    //! Whether the peer has ended the level.
+    bool level_end_{ false };
+
+    LockstepStats stats_{};
+};
+
+}  // namespace game::netpkg
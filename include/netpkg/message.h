@@ -0,0 +1,76 @@
+/**
+ * @file message.h
+ * @brief Network packets of online battles.
+ *
+ * @details
+ * Each message is declared here once.
+ * A new message needs its layout, a declaration and an entry in @p Messages,
+ * and encoders and decoders pick it up at compile time.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "layout.h"
+#include "schema.h"
+
+#include "network/packet.h"
+
+
+namespace game::netpkg {
+
+//! The width of X-coordinates on the game grid.
+inline constexpr std::size_t pos_x_bits{ 4 };
+
+//! The width of Y-coordinates on the game grid.
+inline constexpr std::size_t pos_y_bits{ 3 };
+
+//! The width of item IDs.
+inline constexpr std::size_t id_bits{ 9 };
+
+//! The width of ticks, which covers about ten minutes of 10-millisecond ticks.
+inline constexpr std::size_t tick_bits{ 16 };
+
+//! A plant created by the plant side.
+using NewPlantMessage
+    = Message<Type::NewPlant, NewItem, Field<&NewItem::pos_x, pos_x_bits>,
+              Field<&NewItem::pos_y, pos_y_bits>, Field<&NewItem::id, id_bits>,
+              Field<&NewItem::tick, tick_bits>>;
+
+//! A zombie created by the zombie side.
+using NewZombieMessage
+    = Message<Type::NewZombie, NewItem, Field<&NewItem::pos_x, pos_x_bits>,
+              Field<&NewItem::pos_y, pos_y_bits>, Field<&NewItem::id, id_bits>,
+              Field<&NewItem::tick, tick_bits>>;
+
+//! The end of a level.
+using LevelEndMessage = Message<Type::LevelEnd, Header>;
+
+//! The handshake choosing the encoding.
+using HelloMessage = Message<Type::Hello, Hello, Field<&Hello::encodings>,
+                             Field<&Hello::input_delay>>;
+
+//! The lockstep timeline of a side without events.
+using HeartbeatMessage
+    = Message<Type::Heartbeat, Heartbeat, Field<&Heartbeat::tick, tick_bits>>;
+
+//! All messages.
+using Messages
+    = MessageList<NewPlantMessage, NewZombieMessage, LevelEndMessage,
+                  HelloMessage, HeartbeatMessage>;
+
+static_assert(Messages::max_size <= net::Packet::inline_capacity,
+              "A message must be received without heap allocations.");
+static_assert(NewPlantMessage::packed_size == 4
+                  && NewZombieMessage::packed_size == 4,
+              "A creation event on the game grid must be packed into 4 bytes.");
+
+}  // namespace game::netpkg
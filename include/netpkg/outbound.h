@@ -0,0 +1,113 @@
+/**
+ * @file outbound.h
+ * @brief The outbound queue of game packets.
+ *
+ * @details
+ * Sending on the game thread would stall a frame whenever the peer is slow or the socket buffer is full.
+ * Instead, the game thread only copies each packet into a fixed-size record in the queue,
+ * and a sender thread owning socket writes drains the queue, encodes packets and sends them in batches.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "message.h"
+
+#include "network/mpsc_queue.h"
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stop_token>
+
+
+namespace game::netpkg {
+
+/**
+ * @brief The outbound queue of game packets.
+ *
+ * @details
+ * Packets can be queued on any thread, and they are taken on the sender thread.
+ * Queueing only wakes the sender thread with a system call if it is sleeping.
+ */
+class OutboundQueue final {
+public:
+    //! The maximum number of waiting packets.
+    static constexpr std::size_t capacity{ 1024 };
+
+    OutboundQueue() noexcept = default;
+
+    OutboundQueue(const OutboundQueue&) = delete;
+
+    OutboundQueue& operator=(const OutboundQueue&) = delete;
+
+    /**
+     * @brief Queue a packet on any thread.
+     *
+     * @param packet A packet in the fixed layout.
+     *
+     * @exception std::length_error The packet is larger than any message.
+     * @exception std::runtime_error The queue is full.
+     */
+    void Push(std::span<const std::byte> packet);
+
+    /**
+     * @brief Wait on the sender thread until packets are queued.
+     *
+     * @param stop_token A token cancelling the wait.
+     */
+    void Wait(std::stop_token stop_token);
+
+    /**
+     * @brief Take waiting packets on the sender thread.
+     *
+     * @param send A function called with each packet in a writable buffer.
+     * @return The number of taken packets.
+     */
+    template <std::invocable<std::span<std::byte>> SEND>
+    std::size_t Drain(SEND send) {
+        std::size_t count{ 0 };
+        while (auto record{ records_.TryPop() }) {
+            ++count;
+            send(std::span{ record->data }.first(record->size));
+        }
+
+        return count;
+    }
+
+    //! Get the number of waiting packets, which may be outdated when it returns.
+    std::size_t Depth() const noexcept;
+
+private:
+    //! A packet waiting to be sent.
+    struct Record {
+        std::array<std::byte, Messages::max_size> data;
+
+        std::uint8_t size;
+    };
+
+    static_assert(Messages::max_size
+                  <= std::numeric_limits<std::uint8_t>::max());
+
+    net::MpscQueue<Record, capacity> records_{};
+
+    //! The number of queued packets, which the sender thread waits on.
+    std::atomic<std::uint32_t> pushes_{ 0 };
+
+    //! Whether the sender thread is going to sleep.
+    std::atomic<bool> waiting_{ false };
+};
+
+}  // namespace game::netpkg
@@ -0,0 +1,376 @@
+/**
+ * @file schema.h
+ * @brief The compile-time schema of network packets.
+ *
+ * @details
+ * A message is declared once as a type tag, a fixed layout and a list of fields.
+ * Its wire sizes, factory, encoder and decoder are generated from the declaration,
+ * and each field is handled by a fold expression, so no loops or switches are left at run time.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "layout.h"
+
+#include "network/packet_view.h"
+#include "network/varint.h"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace game::netpkg {
+
+namespace detail {
+
+//! Split a pointer to a data member into the member type and the class.
+template <typename T>
+struct Member;
+
+template <typename VALUE, typename CLASS>
+struct Member<VALUE CLASS::*> {
+    using Value = VALUE;
+    using Class = CLASS;
+};
+
+}  // namespace detail
+
+/**
+ * @brief A field of a message.
+ *
+ * @details
+ * A field is encoded as a variable-length integer, with zigzag encoding if it is signed.
+ * If all fields of a message have widths and their values fit,
+ * they are packed into a little-endian bit field instead.
+ *
+ * @tparam MEMBER A pointer to an integral data member.
+ * @tparam BITS The width in the packed form, or zero if it cannot be packed.
+ */
+template <auto MEMBER, std::size_t BITS = 0>
+struct Field {
+    using Value = typename detail::Member<decltype(MEMBER)>::Value;
+    using Class = typename detail::Member<decltype(MEMBER)>::Class;
+
+    static_assert(std::integral<Value> && !std::same_as<Value, bool>,
+                  "A field must be an integer.");
+    static_assert(BITS < 64 && BITS <= std::numeric_limits<Value>::digits);
+
+    static constexpr auto member{ MEMBER };
+
+    static constexpr std::size_t bits{ BITS };
+
+    //! The maximum size of the variable-length form.
+    static constexpr std::size_t max_varint_size{ (sizeof(Value) * 8 + 6)
+                                                  / 7 };
+
+    //! Check if a value fits in the packed form.
+    static constexpr bool Packs(const Value val) noexcept {
+        return bits != 0 && std::cmp_greater_equal(val, 0)
+               && std::cmp_less(val, std::uint64_t{ 1 } << bits);
+    }
+
+    //! Map a value to the unsigned integer stored in the variable-length form.
+    static constexpr std::uint64_t ToVarint(const Value val) noexcept {
+        if constexpr (std::signed_integral<Value>) {
+            return net::ZigZagEncode(val);
+        } else {
+            return val;
+        }
+    }
+
+    //! Restore a value from the variable-length form, or get an empty value if it is out of range.
+    static constexpr std::optional<Value> FromVarint(
+        const std::uint64_t val) noexcept {
+        if constexpr (std::signed_integral<Value>) {
+            const auto signed_val{ net::ZigZagDecode(val) };
+            if (!std::in_range<Value>(signed_val)) {
+                return std::nullopt;
+            }
+
+            return static_cast<Value>(signed_val);
+        } else {
+            if (!std::in_range<Value>(val)) {
+                return std::nullopt;
+            }
+
+            return static_cast<Value>(val);
+        }
+    }
+};
+
+/**
+ * @brief The schema of a message.
+ *
+ * @tparam TYPE The type tag.
+ * @tparam LAYOUT The fixed layout.
+ * @tparam FIELDS Fields following the header, as @p Field types.
+ */
+template <Type TYPE, std::derived_from<Header> LAYOUT, typename... FIELDS>
+struct Message {
+    using Layout = LAYOUT;
+
+    //! The type tag.
+    static constexpr Type type{ TYPE };
+
+    //! The size of the fixed layout.
+    static constexpr std::size_t size{ sizeof(LAYOUT) };
+
+    //! The size stored in the header of the fixed layout.
+    static constexpr std::size_t body_size{ size - sizeof(net::Header) };
+
+    //! Whether fields can be packed into a bit field.
+    static constexpr bool packable{ sizeof...(FIELDS) != 0
+                                    && ((FIELDS::bits != 0) && ...) };
+
+    //! The number of bits of packed fields.
+    static constexpr std::size_t packed_bits{ (FIELDS::bits + ...
+                                               + std::size_t{ 0 }) };
+
+    //! The size of packed fields.
+    static constexpr std::size_t packed_size{ (packed_bits + 7) / 8 };
+
+    //! The maximum size of encoded fields.
+    static constexpr std::size_t max_fields_size{ std::max(
+        packed_size, (FIELDS::max_varint_size + ... + std::size_t{ 0 })) };
+
+    static_assert(net::PacketLayout<LAYOUT>);
+    static_assert((std::is_base_of_v<typename FIELDS::Class, LAYOUT> && ...),
+                  "Fields must belong to the layout.");
+    static_assert(packed_bits <= 64, "Packed fields must fit in 64 bits.");
+
+    /**
+     * @brief Create a message.
+     *
+     * @param role The sender's role.
+     * @param vals Values of fields in order.
+     * @return A message whose header has been filled in.
+     */
+    static constexpr LAYOUT Make(const Role role,
+                                 const typename FIELDS::Value... vals) noexcept {
+        LAYOUT msg{};
+        msg.size = body_size;
+        msg.type = static_cast<std::uint16_t>(type);
+        msg.role = role;
+        ((msg.*FIELDS::member = vals), ...);
+        return msg;
+    }
+
+    //! Get the fixed layout of a message.
+    static std::span<const std::byte> Bytes(const LAYOUT& msg) noexcept {
+        return std::as_bytes(std::span{ &msg, 1 });
+    }
+
+    /**
+     * @brief Read a message in the fixed layout.
+     *
+     * @param packet A packet including its header, in a buffer of any alignment.
+     * @return A copy of the message.
+     *
+     * @exception std::invalid_argument The packet is too small or of another type.
+     */
+    static LAYOUT Load(const std::span<const std::byte> packet) {
+        const net::PacketView<LAYOUT> view{ packet };
+        if (static_cast<Type>(view.Get(&net::Header::type)) != type) {
+            throw std::invalid_argument{ "The type of packet is mismatched." };
+        }
+
+        return view.Load();
+    }
+
+    //! Check if the fields of a message fit in the packed form.
+    static constexpr bool Packs([[maybe_unused]] const LAYOUT& msg) noexcept {
+        return packable && (FIELDS::Packs(msg.*FIELDS::member) && ...);
+    }
+
+    /**
+     * @brief Write the fields of a message.
+     *
+     * @param msg A message.
+     * @param packed Whether to pack fields, which requires @p Packs(msg).
+     * @param buffer A buffer of at least @p max_fields_size bytes.
+     * @return The written size.
+     */
+    static std::size_t Write([[maybe_unused]] const LAYOUT& msg,
+                             [[maybe_unused]] const bool packed,
+                             [[maybe_unused]] const std::span<std::byte> buffer)
+        noexcept {
+        if constexpr (packable) {
+            if (packed) {
+                std::uint64_t bits{ 0 };
+                std::size_t shift{ 0 };
+                ((bits |= static_cast<std::uint64_t>(msg.*FIELDS::member)
+                          << shift,
+                  shift += FIELDS::bits),
+                 ...);
+                for (std::size_t i{ 0 }; i != packed_size; ++i) {
+                    buffer[i] = static_cast<std::byte>(bits >> (8 * i));
+                }
+
+                return packed_size;
+            }
+        }
+
+        std::size_t size{ 0 };
+        ((size += net::WriteVarint(FIELDS::ToVarint(msg.*FIELDS::member),
+                                   buffer.subspan(size))),
+         ...);
+        return size;
+    }
+
+    /**
+     * @brief Read a message written by @p Write.
+     *
+     * @param data Encoded fields. Read bytes are removed from it.
+     * @param packed Whether fields are packed.
+     * @param role The sender's role.
+     * @return A message whose header has been filled in.
+     *
+     * @exception std::invalid_argument The fields are truncated or out of range.
+     */
+    static LAYOUT Read([[maybe_unused]] std::span<const std::byte>& data,
+                       const bool packed, const Role role) {
+        auto msg{ Make(role, typename FIELDS::Value{}...) };
+        if (!packed) {
+            (ReadVarint<FIELDS>(data, msg), ...);
+            return msg;
+        }
+
+        if constexpr (!packable) {
+            throw std::invalid_argument{ "The message cannot be packed." };
+        } else {
+            if (data.size_bytes() < packed_size) {
+                throw std::invalid_argument{ "The message is truncated." };
+            }
+
+            std::uint64_t bits{ 0 };
+            for (std::size_t i{ 0 }; i != packed_size; ++i) {
+                bits |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+            }
+
+            data = data.subspan(packed_size);
+            ((msg.*FIELDS::member = static_cast<typename FIELDS::Value>(
+                  bits & ((std::uint64_t{ 1 } << FIELDS::bits) - 1)),
+              bits >>= FIELDS::bits),
+             ...);
+            return msg;
+        }
+    }
+
+private:
+    //! Read a field in the variable-length form.
+    template <typename FIELD>
+    static void ReadVarint(std::span<const std::byte>& data, LAYOUT& msg) {
+        const auto encoded{ net::ReadVarint(data) };
+        if (!encoded.has_value()) {
+            throw std::invalid_argument{ "The message is truncated." };
+        }
+
+        const auto val{ FIELD::FromVarint(encoded->first) };
+        if (!val.has_value()) {
+            throw std::invalid_argument{ "A field is out of range." };
+        }
+
+        data = data.subspan(encoded->second);
+        msg.*FIELD::member = *val;
+    }
+};
+
+/**
+ * @brief A list of message schemas.
+ *
+ * @tparam MESSAGES @p Message types with unique type tags.
+ */
+template <typename... MESSAGES>
+struct MessageList {
+    static_assert(sizeof...(MESSAGES) != 0);
+    static_assert(
+        [] {
+            const std::array types{ MESSAGES::type... };
+            for (std::size_t i{ 0 }; i != types.size(); ++i) {
+                for (auto j{ i + 1 }; j != types.size(); ++j) {
+                    if (types[i] == types[j]) {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }(),
+        "Message types must be unique.");
+
+    //! The number of messages.
+    static constexpr std::size_t count{ sizeof...(MESSAGES) };
+
+    //! The maximum size of fixed layouts.
+    static constexpr std::size_t max_size{ std::max({ MESSAGES::size... }) };
+
+    //! The maximum size of encoded fields.
+    static constexpr std::size_t max_fields_size{ std::max(
+        { MESSAGES::max_fields_size... }) };
+
+    //! The maximum value of type tags.
+    static constexpr auto max_type{ std::max(
+        { static_cast<std::underlying_type_t<Type>>(MESSAGES::type)... }) };
+
+    //! Check if a type tag belongs to a message in the list.
+    static constexpr bool Has(const Type type) noexcept {
+        return ((MESSAGES::type == type) || ...);
+    }
+
+    /**
+     * @brief Call a visitor with the schema of a type.
+     *
+     * @details
+     * The visitor is called as @p visitor.template operator()<MESSAGE>(),
+     * and it must return the same type for all messages.
+     *
+     * @param type A type tag.
+     * @param visitor A lambda with a template parameter list.
+     * @return The visitor's result.
+     *
+     * @exception std::invalid_argument The type is unknown.
+     */
+    template <typename VISITOR>
+    static auto Visit(const Type type, VISITOR&& visitor) {
+        using First = std::tuple_element_t<0, std::tuple<MESSAGES...>>;
+        using Result = decltype(visitor.template operator()<First>());
+        if constexpr (std::is_void_v<Result>) {
+            if (!((MESSAGES::type == type
+                   && (visitor.template operator()<MESSAGES>(), true))
+                  || ...)) {
+                throw std::invalid_argument{ "The type of packet is unknown." };
+            }
+        } else {
+            std::optional<Result> result{};
+            if (!((MESSAGES::type == type
+                   && (result.emplace(visitor.template operator()<MESSAGES>()),
+                       true))
+                  || ...)) {
+                throw std::invalid_argument{ "The type of packet is unknown." };
+            }
+
+            return *std::move(result);
+        }
+    }
+};
+
+}  // namespace game::netpkg
@@ -0,0 +1,105 @@
+/**
+ * @file snapshot.h
+ * @brief The ring of recent state snapshots.
+ *
+ * @details
+ * A ring keeps the state before each recent tick, so it can be restored.
+ * The scheduler does not use it, because the game cannot run past ticks again.
+ * Snapshots are copies of contiguous memory regions, such as the amount of sun and the array of plants,
+ * so taking one is a few @p memcpy calls into a buffer allocated when the ring is created.
+ * The oldest snapshot is overwritten when the ring is full.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "layout.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <vector>
+
+
+namespace game::netpkg {
+
+//! The ring of state snapshots.
+class SnapshotRing final {
+public:
+    /**
+     * @brief Create a ring.
+     *
+     * @param depth The maximum number of snapshots, which limits how far back the state can be restored.
+     * @param capacity The maximum size of a snapshot.
+     *
+     * @exception std::invalid_argument The depth or the capacity is zero.
+     */
+    SnapshotRing(std::size_t depth, std::size_t capacity);
+
+    /**
+     * @brief Save the state before a tick.
+     *
+     * @param tick A tick, which must be after all saved ones.
+     * @param regions Memory regions, which are copied one after another.
+     *
+     * @exception std::length_error The regions are larger than the capacity.
+     */
+    void Save(Tick tick,
+              std::initializer_list<std::span<const std::byte>> regions);
+
+    /**
+     * @brief Take the state before a tick and discard it with later snapshots.
+     *
+     * @details Ticks after it will be run again and saved again.
+     *
+     * @param tick A tick.
+     * @return The copied regions, which are valid until the next saving,
+     * or an empty value if the tick has been overwritten or never saved.
+     */
+    std::optional<std::span<const std::byte>> Rewind(Tick tick) noexcept;
+
+    //! Discard all snapshots.
+    void Clear() noexcept;
+
+    //! Get the number of saved snapshots.
+    std::size_t Size() const noexcept;
+
+    //! Get the maximum number of snapshots.
+    std::size_t Depth() const noexcept;
+
+    //! Get the maximum size of a snapshot.
+    std::size_t Capacity() const noexcept;
+
+private:
+    struct Snapshot {
+        Tick tick;
+
+        std::size_t size;
+    };
+
+    //! Get the buffer of a slot.
+    std::span<std::byte> Buffer(std::size_t slot) noexcept;
+
+    std::size_t capacity_;
+
+    //! Buffers of all slots in one allocation.
+    std::vector<std::byte> buffers_;
+
+    std::vector<Snapshot> snapshots_;
+
+    //! The slot of the oldest snapshot.
+    std::size_t head_{ 0 };
+
+    std::size_t size_{ 0 };
+};
+
+}  // namespace game::netpkg
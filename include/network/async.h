@@ -0,0 +1,430 @@
+/**
+ * @file async.h
+ * @brief Coroutines driven by the event loop.
+ *
+ * @details
+ * @p Task is a lazy coroutine type and @p Executor runs tasks on a @p Reactor.
+ * Coroutines wait for socket readiness or timers without blocking the loop thread,
+ * and every wait can be cancelled by a @p std::stop_token.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "platform.h"
+#include "reactor.h"
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stop_token>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+
+namespace net {
+
+template <typename T = void>
+class Task;
+
+class Executor;
+
+/**
+ * @brief Throw a @p std::system_error exception meaning the operation has been cancelled.
+ *
+ * @exception std::system_error The operation has been cancelled.
+ */
+[[noreturn]] void ThrowCancelled();
+
+namespace detail {
+
+//! The awaiter resuming the awaiting coroutine when a task finishes.
+struct FinalAwaiter {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    template <typename PROMISE>
+    std::coroutine_handle<> await_suspend(
+        const std::coroutine_handle<PROMISE> handle) const noexcept {
+        return handle.promise().continuation;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+class PromiseBase {
+public:
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        error_ = std::current_exception();
+    }
+
+    //! The coroutine awaiting the task.
+    std::coroutine_handle<> continuation{ std::noop_coroutine() };
+
+protected:
+    void Rethrow() const {
+        if (error_ != nullptr) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+private:
+    std::exception_ptr error_{};
+};
+
+template <typename T>
+class Promise : public PromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <std::convertible_to<T> U>
+    void return_value(U&& val) {
+        val_.emplace(std::forward<U>(val));
+    }
+
+    T Result() {
+        Rethrow();
+        return std::move(val_.value());
+    }
+
+private:
+    std::optional<T> val_{};
+};
+
+template <>
+class Promise<void> : public PromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void Result() const {
+        Rethrow();
+    }
+};
+
+}  // namespace detail
+
+/**
+ * @brief A lazy coroutine.
+ *
+ * @details
+ * It does not start until it is awaited or spawned by an @p Executor.
+ * Exceptions are re-thrown to the awaiting coroutine.
+ *
+ * @tparam T The result type.
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::Promise<T>;
+
+    Task(Task&& that) noexcept : handle_{ std::exchange(that.handle_, {}) } {}
+
+    Task& operator=(Task&& that) & noexcept {
+        if (this != &that) {
+            Destroy();
+            handle_ = std::exchange(that.handle_, {});
+        }
+
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+
+    Task& operator=(const Task&) = delete;
+
+    ~Task() noexcept {
+        Destroy();
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    std::coroutine_handle<> await_suspend(
+        const std::coroutine_handle<> caller) const noexcept {
+        handle_.promise().continuation = caller;
+        return handle_;
+    }
+
+    T await_resume() const {
+        return handle_.promise().Result();
+    }
+
+private:
+    friend promise_type;
+
+    explicit Task(const std::coroutine_handle<promise_type> handle) noexcept :
+        handle_{ handle } {}
+
+    void Destroy() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_{};
+};
+
+template <typename T>
+Task<T> detail::Promise<T>::get_return_object() noexcept {
+    return Task<T>{ std::coroutine_handle<Promise>::from_promise(*this) };
+}
+
+inline Task<void> detail::Promise<void>::get_return_object() noexcept {
+    return Task<void>{ std::coroutine_handle<Promise>::from_promise(*this) };
+}
+
+
+/**
+ * @brief The awaiter waiting for a socket to be readable or writable.
+ *
+ * @details
+ * If the socket reports an error, the coroutine is resumed as if it were ready,
+ * so the following operation can get the error.
+ */
+class ReadinessAwaiter final {
+public:
+    ReadinessAwaiter(Executor& executor, SocketId id, Event event,
+                     std::stop_token stop_token) noexcept;
+
+    ~ReadinessAwaiter() noexcept;
+
+    ReadinessAwaiter(const ReadinessAwaiter&) = delete;
+
+    ReadinessAwaiter& operator=(const ReadinessAwaiter&) = delete;
+
+    bool await_ready() noexcept;
+
+    void await_suspend(std::coroutine_handle<> handle);
+
+    /**
+     * @exception std::system_error The wait has been cancelled.
+     */
+    void await_resume() const;
+
+private:
+    friend class Executor;
+
+    //! The stop callback cancelling the wait on the loop thread.
+    struct Canceller {
+        void operator()() const noexcept;
+
+        Executor* executor;
+        SocketId id;
+        Event event;
+        std::coroutine_handle<> handle;
+    };
+
+    Executor& executor_;
+    SocketId id_;
+    Event event_;
+    std::stop_token stop_token_;
+
+    std::coroutine_handle<> handle_{};
+    bool pending_{ false };
+    bool cancelled_{ false };
+    std::optional<std::stop_callback<Canceller>> on_stop_{};
+};
+
+//! The awaiter waiting for a period of time.
+class SleepAwaiter final {
+public:
+    SleepAwaiter(Executor& executor, Reactor::Clock::duration delay,
+                 std::stop_token stop_token) noexcept;
+
+    ~SleepAwaiter() noexcept;
+
+    SleepAwaiter(const SleepAwaiter&) = delete;
+
+    SleepAwaiter& operator=(const SleepAwaiter&) = delete;
+
+    bool await_ready() noexcept;
+
+    void await_suspend(std::coroutine_handle<> handle);
+
+    /**
+     * @exception std::system_error The wait has been cancelled.
+     */
+    void await_resume() const;
+
+private:
+    friend class Executor;
+
+    struct Canceller {
+        void operator()() const noexcept;
+
+        Executor* executor;
+        Reactor::TimerId timer;
+        std::coroutine_handle<> handle;
+    };
+
+    Executor& executor_;
+    Reactor::Clock::duration delay_;
+    std::stop_token stop_token_;
+
+    std::coroutine_handle<> handle_{};
+    Reactor::TimerId timer_{ 0 };
+    bool pending_{ false };
+    bool cancelled_{ false };
+    std::optional<std::stop_callback<Canceller>> on_stop_{};
+};
+
+
+/**
+ * @brief The executor running coroutines on an event loop.
+ *
+ * @details
+ * Except @p Stop, methods must be called from the thread running the loop,
+ * or before the loop starts.
+ * The reactor must not run again after the executor is destroyed.
+ */
+class Executor final {
+public:
+    explicit Executor(Reactor& reactor) noexcept;
+
+    //! Destroy unfinished tasks.
+    ~Executor() noexcept;
+
+    Executor(const Executor&) = delete;
+
+    Executor& operator=(const Executor&) = delete;
+
+    //! Get the event loop.
+    Reactor& EventLoop() const noexcept;
+
+    /**
+     * @brief Run a task in the background.
+     *
+     * @details
+     * The task starts in the next loop iteration.
+     * If it throws an exception, the loop stops and @p Run re-throws it.
+     */
+    void Spawn(Task<> task);
+
+    /**
+     * @brief Run the event loop until it is stopped.
+     *
+     * @exception std::exception An exception thrown by a spawned task or the loop.
+     */
+    void Run();
+
+    //! Stop the event loop. It is thread-safe.
+    void Stop() noexcept;
+
+    /**
+     * @brief Get the executor running on the current thread.
+     *
+     * @exception std::logic_error No executor is running.
+     */
+    static Executor& Current();
+
+    //! Wait for a socket to be readable.
+    ReadinessAwaiter Readable(SocketId id, std::stop_token stop_token = {});
+
+    //! Wait for a socket to be writable.
+    ReadinessAwaiter Writable(SocketId id, std::stop_token stop_token = {});
+
+    //! Wait for a period of time.
+    SleepAwaiter Sleep(Reactor::Clock::duration delay,
+                       std::stop_token stop_token = {});
+
+private:
+    friend class ReadinessAwaiter;
+    friend class SleepAwaiter;
+
+    //! The coroutine driving a spawned task.
+    struct Detached {
+        struct promise_type {
+            promise_type(Executor& executor, Task<>&) noexcept;
+
+            Detached get_return_object() noexcept;
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            //! The awaiter destroying the finished coroutine.
+            struct FinalAwaiter {
+                bool await_ready() const noexcept {
+                    return false;
+                }
+
+                void await_suspend(
+                    std::coroutine_handle<promise_type> handle) const noexcept;
+
+                void await_resume() const noexcept {}
+            };
+
+            FinalAwaiter final_suspend() const noexcept {
+                return {};
+            }
+
+            void return_void() const noexcept {}
+
+            void unhandled_exception() const noexcept;
+
+            Executor& executor;
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    //! Coroutines waiting for a socket.
+    struct Waiters {
+        ReadinessAwaiter* reader;
+        ReadinessAwaiter* writer;
+    };
+
+    static Detached Drive(Executor& executor, Task<> task);
+
+    //! Register a waiting coroutine.
+    void Wait(ReadinessAwaiter& awaiter);
+
+    //! Unregister a waiting coroutine without resuming it.
+    void Unwait(ReadinessAwaiter& awaiter) noexcept;
+
+    //! Resume coroutines waiting for a socket.
+    void OnEvents(SocketId id, Event events);
+
+    //! Cancel a wait if the coroutine is still waiting.
+    void Cancel(SocketId id, Event event, std::coroutine_handle<> handle);
+
+    //! Cancel a sleep if the coroutine is still sleeping.
+    void Cancel(Reactor::TimerId timer, std::coroutine_handle<> handle);
+
+    Reactor& reactor_;
+
+    std::unordered_map<SocketId, Waiters> waiters_{};
+
+    std::unordered_map<Reactor::TimerId, SleepAwaiter*> sleepers_{};
+
+    //! Coroutines driving spawned tasks.
+    std::unordered_set<void*> tasks_{};
+
+    //! The first exception thrown by a spawned task.
+    std::exception_ptr error_{};
+};
+
+}  // namespace net
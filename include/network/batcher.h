@@ -0,0 +1,282 @@
+/**
+ * @file batcher.h
+ * @brief The outbound batcher of packets.
+ *
+ * @details
+ * A batcher copies small packets into one buffer and sends them with a single call,
+ * either when the oldest one has waited for a delay or when the buffer is full.
+ * A batch is a plain sequence of packets, so receivers need no changes.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "packet.h"
+#include "socket/tcp.h"
+
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+
+namespace net {
+
+/**
+ * @brief The outbound batcher of a packet stream.
+ *
+ * @details
+ * Methods are thread-safe, so packets can be appended on one thread
+ * while a timer on another thread flushes them.
+ * Flushing the batch when its deadline arrives is up to the owner,
+ * by calling @p Poll once per frame or @p Flush from a timer.
+ *
+ * @tparam SOCKET A stream socket.
+ */
+template <StreamSocket SOCKET>
+class Batcher final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! The default capacity of a batch.
+    static constexpr std::size_t default_capacity{ 4096 };
+
+    //! The default maximum time a packet waits in a batch.
+    static constexpr std::chrono::microseconds default_delay{ 2000 };
+
+    /**
+     * @brief Create a batcher.
+     *
+     * @param socket A connected socket. It must outlive the batcher.
+     * @param delay The maximum time a packet waits in a batch. Zero disables batching.
+     * @param capacity The size of data that triggers a flush.
+     *
+     * @exception std::invalid_argument The delay is negative or the capacity is zero.
+     */
+    explicit Batcher(SOCKET& socket,
+                     std::chrono::microseconds delay = default_delay,
+                     std::size_t capacity = default_capacity);
+
+    Batcher(const Batcher&) = delete;
+
+    Batcher& operator=(const Batcher&) = delete;
+
+    /**
+     * @brief Append a packet to the batch.
+     *
+     * @details
+     * The header is sealed as @p Packet::Send does.
+     * The batch is flushed first if the packet does not fit,
+     * and at once if batching is disabled or the packet fills it.
+     *
+     * @tparam HEADER A header derived from @p Header.
+     * @param header A header, whose base @p Header is left in little-endian order.
+     * @param payload Payload buffers following the header.
+     * @return Whether the packet starts a new batch, which is due after the delay.
+     *
+     * @exception std::length_error The packet is too large.
+     * @exception std::system_error The operation failed.
+     */
+    template <std::derived_from<Header> HEADER>
+    bool Append(HEADER& header,
+                std::span<const std::span<const std::byte>> payload = {});
+
+    /**
+     * @brief Append an encoded packet to the batch as it is.
+     *
+     * @param packet A packet including its framing.
+     * @return Whether the packet starts a new batch, which is due after the delay.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    bool Append(std::span<const std::byte> packet);
+
+    /**
+     * @brief Send all packets in the batch with one call.
+     *
+     * @details Packets are dropped if sending fails, since the stream is broken then.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    void Flush();
+
+    /**
+     * @brief Flush the batch if it is due.
+     *
+     * @param now The current time.
+     * @return Whether the batch has been flushed.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    bool Poll(Clock::time_point now = Clock::now());
+
+    //! Get the time when the batch is due, or an empty value if it is empty.
+    std::optional<Clock::time_point> Deadline() const;
+
+    //! Get the number of packets in the batch.
+    std::size_t Pending() const;
+
+    //! Get the maximum time a packet waits in a batch.
+    std::chrono::microseconds Delay() const noexcept;
+
+private:
+    //! Append a packet made up of a head and payload buffers.
+    bool Push(std::span<const std::byte> head,
+              std::span<const std::span<const std::byte>> payload);
+
+    //! Send all buffered data. The lock must be held.
+    void FlushLocked();
+
+    SOCKET& socket_;
+
+    const std::chrono::microseconds delay_;
+
+    const std::size_t capacity_;
+
+    mutable std::mutex mtx_{};
+
+    std::vector<std::byte> buffer_{};
+
+    std::size_t pending_{ 0 };
+
+    //! When the oldest packet in the batch was appended.
+    Clock::time_point since_{};
+};
+
+
+template <StreamSocket SOCKET>
+Batcher<SOCKET>::Batcher(SOCKET& socket, const std::chrono::microseconds delay,
+                         const std::size_t capacity) :
+    socket_{ socket }, delay_{ delay }, capacity_{ capacity } {
+    if (delay_ < std::chrono::microseconds::zero()) {
+        throw std::invalid_argument{ "The delay is negative." };
+    } else if (capacity_ == 0) {
+        throw std::invalid_argument{ "The capacity is zero." };
+    }
+
+    buffer_.reserve(capacity_);
+}
+
+template <StreamSocket SOCKET>
+template <std::derived_from<Header> HEADER>
+bool Batcher<SOCKET>::Append(
+    HEADER& header, const std::span<const std::span<const std::byte>> payload) {
+    Seal({ reinterpret_cast<std::byte*>(&header), sizeof(header) }, payload);
+    return Push({ reinterpret_cast<const std::byte*>(&header), sizeof(header) },
+                payload);
+}
+
+template <StreamSocket SOCKET>
+bool Batcher<SOCKET>::Append(const std::span<const std::byte> packet) {
+    return Push(packet, {});
+}
+
+template <StreamSocket SOCKET>
+bool Batcher<SOCKET>::Push(
+    const std::span<const std::byte> head,
+    const std::span<const std::span<const std::byte>> payload) {
+    auto size{ head.size_bytes() };
+    for (const auto buffer : payload) {
+        size += buffer.size_bytes();
+    }
+
+    const std::lock_guard lock{ mtx_ };
+    if (!buffer_.empty() && buffer_.size() + size > capacity_) {
+        FlushLocked();
+    }
+
+    const auto append{ [this](const std::span<const std::byte> data) {
+        const auto offset{ buffer_.size() };
+        buffer_.resize(offset + data.size_bytes());
+        std::memcpy(buffer_.data() + offset, data.data(), data.size_bytes());
+    } };
+
+    append(head);
+    for (const auto buffer : payload) {
+        append(buffer);
+    }
+
+    const auto started{ pending_++ == 0 };
+    if (started) {
+        since_ = Clock::now();
+    }
+
+    if (delay_ == std::chrono::microseconds::zero()
+        || buffer_.size() >= capacity_) {
+        FlushLocked();
+        return false;
+    }
+
+    return started;
+}
+
+template <StreamSocket SOCKET>
+void Batcher<SOCKET>::Flush() {
+    const std::lock_guard lock{ mtx_ };
+    FlushLocked();
+}
+
+template <StreamSocket SOCKET>
+bool Batcher<SOCKET>::Poll(const Clock::time_point now) {
+    const std::lock_guard lock{ mtx_ };
+    if (pending_ == 0 || now < since_ + delay_) {
+        return false;
+    }
+
+    FlushLocked();
+    return true;
+}
+
+template <StreamSocket SOCKET>
+std::optional<typename Batcher<SOCKET>::Clock::time_point>
+Batcher<SOCKET>::Deadline() const {
+    const std::lock_guard lock{ mtx_ };
+    if (pending_ == 0) {
+        return std::nullopt;
+    }
+
+    return since_ + delay_;
+}
+
+template <StreamSocket SOCKET>
+std::size_t Batcher<SOCKET>::Pending() const {
+    const std::lock_guard lock{ mtx_ };
+    return pending_;
+}
+
+template <StreamSocket SOCKET>
+std::chrono::microseconds Batcher<SOCKET>::Delay() const noexcept {
+    return delay_;
+}
+
+template <StreamSocket SOCKET>
+void Batcher<SOCKET>::FlushLocked() {
+    try {
+        std::span<const std::byte> data{ buffer_ };
+        while (!data.empty()) {
+            data = data.subspan(socket_.Send(data));
+        }
+    } catch (...) {
+        buffer_.clear();
+        pending_ = 0;
+        throw;
+    }
+
+    buffer_.clear();
+    pending_ = 0;
+}
+
+}  // namespace net
@@ -0,0 +1,87 @@
+/**
+ * @file buffer_pool.h
+ * @brief The lock-free pool of byte blocks.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <span>
+
+
+namespace net {
+
+/**
+ * @brief The lock-free pool of byte blocks.
+ *
+ * @details
+ * Blocks are grouped by power-of-two sizes.
+ * Each size class keeps a fixed number of free blocks in atomic slots,
+ * so acquiring and releasing never lock and have no ABA problem.
+ * Blocks beyond the largest class, or released into a full class, go to the heap.
+ */
+class BufferPool final {
+public:
+    //! The size of the smallest block.
+    static constexpr std::size_t min_block_size{ 128 };
+
+    //! The size of the largest pooled block.
+    static constexpr std::size_t max_block_size{ 64 * 1024 };
+
+    //! The maximum number of free blocks kept for each size class.
+    static constexpr std::size_t slots_per_class{ 16 };
+
+    BufferPool() noexcept = default;
+
+    //! Free all cached blocks.
+    ~BufferPool() noexcept;
+
+    BufferPool(const BufferPool&) = delete;
+
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    //! Get the pool shared by the process.
+    static BufferPool& Shared() noexcept;
+
+    /**
+     * @brief Get a block.
+     *
+     * @param size The minimum size.
+     * @return A block whose size is rounded up to its size class.
+     *
+     * @exception std::bad_alloc There is not enough memory.
+     */
+    std::span<std::byte> Acquire(std::size_t size);
+
+    /**
+     * @brief Return a block acquired from the pool.
+     *
+     * @param block A block with its full size.
+     */
+    void Release(std::span<std::byte> block) noexcept;
+
+private:
+    //! The number of size classes.
+    static constexpr std::size_t class_num{ 10 };
+
+    static_assert(min_block_size << (class_num - 1) == max_block_size);
+
+    //! Get the size class of a block size, which must not exceed @p max_block_size.
+    static std::size_t SizeClass(std::size_t size) noexcept;
+
+    std::array<std::array<std::atomic<std::byte*>, slots_per_class>, class_num>
+        free_{};
+};
+
+}  // namespace net
@@ -0,0 +1,59 @@
+/**
+ * @file byte_order.h
+ * @brief Little-endian loads and stores.
+ *
+ * @details
+ * Wire formats store integers in little-endian order.
+ * These functions read and write them in buffers of any alignment on hosts of either order.
+ * Compilers turn them into plain loads and stores on little-endian hosts.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+
+
+namespace net {
+
+/**
+ * @brief Convert an integer between the native order and the little-endian order.
+ *
+ * @details The conversion is its own inverse.
+ */
+template <std::integral T>
+constexpr T LittleEndian(const T val) noexcept {
+    if constexpr (std::endian::native == std::endian::big) {
+        return std::byteswap(val);
+    } else {
+        return val;
+    }
+}
+
+//! Load an integer stored in little-endian order.
+template <std::integral T>
+T LoadLittle(const std::byte* const data) noexcept {
+    T val;
+    std::memcpy(&val, data, sizeof(val));
+    return LittleEndian(val);
+}
+
+//! Store an integer in little-endian order.
+template <std::integral T>
+void StoreLittle(std::byte* const data, const T val) noexcept {
+    const auto little{ LittleEndian(val) };
+    std::memcpy(data, &little, sizeof(little));
+}
+
+}  // namespace net
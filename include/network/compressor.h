@@ -0,0 +1,181 @@
+/**
+ * @file compressor.h
+ * @brief The streaming compression of packets.
+ *
+ * @details
+ * It is a byte-oriented LZ77 variant made for short and repetitive packets.
+ * A stream is compressed block by block, and a block can refer to data in previous blocks,
+ * so a packet repeating a recent one takes only a few bytes.
+ * Both sides can be primed with the same dictionary of common data.
+ *
+ * A block is a sequence of tokens.
+ *
+ * | Control byte  | Meaning                                                                 |
+ * | ------------- | ----------------------------------------------------------------------- |
+ * | @p 0x00-0x7F  | A literal run of <tt>control + 1</tt> bytes, which follow the control byte. |
+ * | @p 0x80-0xFF  | A match of <tt>(control & 0x7F) + min_match</tt> bytes. A variable-length distance follows. |
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "packet.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace net {
+
+//! The maximum distance of a match, which is also the size of history kept by both sides.
+inline constexpr std::size_t compress_window{ 4096 };
+
+/**
+ * @brief Build a dictionary from sample packets.
+ *
+ * @details
+ * The most frequent samples are kept, and the most frequent one is placed last,
+ * where it can be referred to with the shortest distance.
+ *
+ * @param samples Sample packets.
+ * @param max_size The maximum dictionary size, which is no larger than @p compress_window.
+ * @return A dictionary.
+ */
+std::vector<std::byte> TrainDictionary(
+    std::span<const std::span<const std::byte>> samples,
+    std::size_t max_size = compress_window);
+
+//! The streaming compressor.
+class Compressor final {
+public:
+    //! Get the maximum compressed size of data.
+    static constexpr std::size_t MaxCompressedSize(
+        const std::size_t size) noexcept {
+        return size + size / (max_literals - 1) + 1;
+    }
+
+    /**
+     * @brief Create a compressor.
+     *
+     * @param dictionary A dictionary shared with the decompressor.
+     */
+    explicit Compressor(std::span<const std::byte> dictionary = {});
+
+    /**
+     * @brief Compress a block of the stream.
+     *
+     * @details
+     * Blocks must be decompressed in the same order by one decompressor.
+     *
+     * @param data Data.
+     * @param out A buffer the compressed block is appended to.
+     * @return The compressed size.
+     */
+    std::size_t Compress(std::span<const std::byte> data,
+                         std::vector<std::byte>& out);
+
+    /**
+     * @brief Compress a block into a packet.
+     *
+     * @param data Data.
+     * @return A packet whose body is the compressed block.
+     */
+    Packet CompressPacket(std::span<const std::byte> data);
+
+    //! Forget the stream and start from the dictionary again.
+    void Reset();
+
+private:
+    friend class Decompressor;
+
+    //! The maximum length of a literal run.
+    static constexpr std::size_t max_literals{ 0x80 };
+
+    //! The minimum length of a match.
+    static constexpr std::size_t min_match{ 4 };
+
+    //! The maximum length of a match.
+    static constexpr std::size_t max_match{ 0x7F + min_match };
+
+    //! The number of bits of hash values.
+    static constexpr std::size_t hash_bits{ 12 };
+
+    //! The position of empty hash entries.
+    static constexpr std::int32_t no_pos{ -1 };
+
+    //! Get the hash value of the 4 bytes at a position in history.
+    std::size_t Hash(std::size_t pos) const noexcept;
+
+    //! Record the position of the 4 bytes starting at it.
+    void Insert(std::size_t pos) noexcept;
+
+    //! Drop old history to make room for a block of a size.
+    void Slide(std::size_t size) noexcept;
+
+    //! Compress a block no larger than @p compress_window.
+    void CompressChunk(std::span<const std::byte> data,
+                       std::vector<std::byte>& out);
+
+    std::vector<std::byte> dictionary_;
+
+    std::vector<std::byte> history_{};
+
+    //! The latest position of each hash value in history.
+    std::array<std::int32_t, 1 << hash_bits> head_{};
+};
+
+//! The streaming decompressor.
+class Decompressor final {
+public:
+    /**
+     * @brief Create a decompressor.
+     *
+     * @param dictionary A dictionary shared with the compressor.
+     */
+    explicit Decompressor(std::span<const std::byte> dictionary = {});
+
+    /**
+     * @brief Decompress a block of the stream.
+     *
+     * @param block A compressed block.
+     * @param out A buffer decompressed data is appended to.
+     * @return The decompressed size.
+     *
+     * @exception std::invalid_argument The block is malformed.
+     */
+    std::size_t Decompress(std::span<const std::byte> block,
+                           std::vector<std::byte>& out);
+
+    /**
+     * @brief Decompress a packet created by @p Compressor::CompressPacket.
+     *
+     * @param packet A packet including its header.
+     * @param out A buffer decompressed data is appended to.
+     * @return The decompressed size.
+     *
+     * @exception std::invalid_argument The packet is malformed.
+     */
+    std::size_t DecompressPacket(std::span<const std::byte> packet,
+                                 std::vector<std::byte>& out);
+
+    //! Forget the stream and start from the dictionary again.
+    void Reset();
+
+private:
+    std::vector<std::byte> dictionary_;
+
+    std::vector<std::byte> history_{};
+};
+
+}  // namespace net
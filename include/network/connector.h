@@ -0,0 +1,108 @@
+/**
+ * @file connector.h
+ * @brief Dual-stack connecting with a timeout.
+ *
+ * @details
+ * A host name may be resolved into both IPv6 and IPv4 addresses, and one of the paths may be dead.
+ * Instead of waiting for the system timeout of each address in turn,
+ * attempts are raced with staggered starts as described by RFC 8305 "Happy Eyeballs",
+ * and the first connected socket wins.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "async.h"
+#include "ip_addr.h"
+#include "resolver.h"
+#include "socket/tcp.h"
+
+#include <chrono>
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace net {
+
+//! Options of connecting.
+struct ConnectOptions {
+    //! The maximum time to connect, including all attempts.
+    std::chrono::milliseconds timeout{ 3000 };
+
+    //! The delay before starting the next attempt while earlier ones are still pending.
+    std::chrono::milliseconds attempt_delay{ 250 };
+};
+
+/**
+ * @brief Resolve a host name or a numeric IP address.
+ *
+ * @details
+ * Addresses are ordered by the system preference,
+ * then interleaved by version so that a dead path of one version does not delay the other.
+ *
+ * @param host A host name or a numeric IP address.
+ * @param port A port number.
+ * @return Non-empty addresses.
+ *
+ * @exception std::runtime_error The resolution failed.
+ */
+std::vector<SockAddr> Resolve(std::string_view host, std::uint16_t port);
+
+/**
+ * @brief Connect to the first reachable address in a coroutine.
+ *
+ * @details
+ * Attempts start in order, each one @p ConnectOptions::attempt_delay after the previous one,
+ * or immediately after all pending attempts fail.
+ * The first connected socket is returned in blocking mode and the others are closed.
+ *
+ * @param addrs Addresses in preference order.
+ * @param options Options.
+ * @param stop_token A token cancelling the operation.
+ *
+ * @exception std::invalid_argument There is no address.
+ * @exception std::system_error
+ * All attempts failed, the timeout expired or the operation has been cancelled.
+ */
+Task<TcpSocket<SockAddr>> AsyncConnectAny(std::vector<SockAddr> addrs,
+                                          ConnectOptions options = {},
+                                          std::stop_token stop_token = {});
+
+/**
+ * @brief Resolve a host and connect to the first reachable address in a coroutine.
+ *
+ * @details The timeout does not include the resolution.
+ *
+ * @param resolver A resolver, which may have a cached result of the host.
+ *
+ * @exception std::runtime_error The resolution failed.
+ * @exception std::system_error
+ * All attempts failed, the timeout expired or the operation has been cancelled.
+ */
+Task<TcpSocket<SockAddr>> AsyncConnectHost(Resolver& resolver,
+                                           std::string host,
+                                           std::uint16_t port,
+                                           ConnectOptions options = {},
+                                           std::stop_token stop_token = {});
+
+/**
+ * @brief Connect to the first reachable address on a private event loop.
+ *
+ * @exception std::invalid_argument There is no address.
+ * @exception std::system_error All attempts failed or the timeout expired.
+ */
+TcpSocket<SockAddr> ConnectAny(std::vector<SockAddr> addrs,
+                               ConnectOptions options = {});
+
+}  // namespace net
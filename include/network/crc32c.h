@@ -0,0 +1,45 @@
+/**
+ * @file crc32c.h
+ * @brief The CRC32C checksum.
+ *
+ * @details
+ * The Castagnoli polynomial is computed by hardware instructions when the processor has them,
+ * which are SSE4.2 on x86 and the CRC32 extension on ARM64.
+ * Otherwise a portable slicing-by-8 table is used.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace net {
+
+/**
+ * @brief Compute the CRC32C checksum of data.
+ *
+ * @details
+ * Checksums can be chained, so @p Crc32c(b, Crc32c(a)) equals the checksum of @p a followed by @p b.
+ *
+ * @param data Data.
+ * @param crc The checksum of preceding data, or @p 0 to start.
+ * @return The checksum.
+ */
+std::uint32_t Crc32c(std::span<const std::byte> data,
+                     std::uint32_t crc = 0) noexcept;
+
+//! Check if the checksum is computed by hardware instructions.
+bool HardwareCrc32c() noexcept;
+
+}  // namespace net
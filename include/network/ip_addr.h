@@ -14,13 +14,11 @@
 
 #pragma once
 
-#define _WINSOCKAPI_
-
-#include <winsock2.h>
-#include <ws2tcpip.h>
+#include "platform.h"
 
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 namespace net {
@@ -53,6 +51,15 @@ public:
 
     explicit Ipv4Addr(const sockaddr_in& addr) noexcept;
 
+    /**
+     * @brief Construct an address from a numeric string.
+     *
+     * @param ip A numeric IP address.
+     * @param port A port number.
+     *
+     * @exception std::invalid_argument The IP address is invalid.
+     * @exception std::system_error The operation failed.
+     */
     explicit Ipv4Addr(std::string_view ip, std::uint16_t port);
 
     int Version() const noexcept override;
@@ -78,6 +85,15 @@ public:
 
     explicit Ipv6Addr(const sockaddr_in6& addr) noexcept;
 
+    /**
+     * @brief Construct an address from a numeric string.
+     *
+     * @param ip A numeric IP address.
+     * @param port A port number.
+     *
+     * @exception std::invalid_argument The IP address is invalid.
+     * @exception std::system_error The operation failed.
+     */
     explicit Ipv6Addr(std::string_view ip, std::uint16_t port);
 
     int Version() const noexcept override;
@@ -90,6 +106,57 @@ private:
     sockaddr_in6 addr_{};
 };
 
+/**
+ * @brief The IPv4 or IPv6 address whose version is chosen at runtime.
+ *
+ * @details
+ * Sockets using it are created with the version of the address they connect to or bind,
+ * so one build supports both versions.
+ */
+class SockAddr final : public IpAddr {
+public:
+    //! The version is unknown until an address is set.
+    static constexpr int version{ AF_UNSPEC };
+
+    using RawType = sockaddr_storage;
+
+    explicit SockAddr(const sockaddr_storage& addr) noexcept;
+
+    SockAddr(const Ipv4Addr& addr) noexcept;
+
+    SockAddr(const Ipv6Addr& addr) noexcept;
+
+    /**
+     * @brief Construct an address from a low-level socket address.
+     *
+     * @param addr A socket address.
+     * @param size The size of the socket address.
+     *
+     * @exception std::invalid_argument The address is neither IPv4 nor IPv6.
+     */
+    SockAddr(const sockaddr* addr, std::size_t size);
+
+    /**
+     * @brief Construct an address from a numeric IPv4 or IPv6 string.
+     *
+     * @param ip A numeric IP address.
+     * @param port A port number.
+     *
+     * @exception std::invalid_argument The IP address is invalid.
+     * @exception std::system_error The operation failed.
+     */
+    explicit SockAddr(std::string_view ip, std::uint16_t port);
+
+    int Version() const noexcept override;
+
+    std::size_t Size() const noexcept override;
+
+    const sockaddr* Raw() const noexcept override;
+
+private:
+    sockaddr_storage addr_{};
+};
+
 template <typename T>
 concept ValidIpAddr =
     std::derived_from<T, IpAddr> && !std::same_as<T, IpAddr> && requires(T) {
@@ -14,18 +14,30 @@
 
 #pragma once
 
-#define _WINSOCKAPI_
-
+#include "async.h"
 #include "ip_addr.h"
+#include "platform.h"
+#include "reactor.h"
+#include "socket/option.h"
 #include "socket/tcp.h"
 
-#include "system/windows_error.h"
-
-#include <winsock2.h>
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
 
 
 namespace net {
 
+//! The default maximum number of connections accepted by a batch.
+inline constexpr std::size_t default_accept_batch{ 64 };
+
 /**
  * @brief The TCP server.
  *
@@ -34,25 +46,55 @@ namespace net {
 template <ValidIpAddr ADDR>
 class Listener final {
 public:
+    //! The handler taking an accepted connection.
+    using Handler = std::function<void(TcpSocket<ADDR>)>;
+
     /**
-     * @brief Bind an IP address to the server.
+     * @brief Create the server socket and bind an IP address to it.
+     *
+     * @details An IPv6 server also accepts IPv4 connections with IPv4-mapped addresses.
      *
      * @param addr An IP address.
+     * @param reuse_port
+     * Whether other servers can bind the same address with @p SO_REUSEPORT.
+     * It is not supported on Windows.
      *
+     * @exception std::invalid_argument @p SO_REUSEPORT is not supported.
      * @exception std::system_error The operation failed.
      */
-    void Bind(const ADDR& addr);
+    void Bind(const ADDR& addr, bool reuse_port = false);
 
     /**
      * @brief Start to listen.
      *
+     * @param backlog The maximum length of the queue of pending connections.
+     *
      * @exception std::system_error The operation failed.
      */
-    void Listen();
+    void Listen(int backlog = SOMAXCONN);
 
     //! Close the server.
     void Close() noexcept;
 
+    //! Get the low-level socket handle.
+    SocketId ID() const noexcept;
+
+    /**
+     * @brief Get the local IP address, whose port is assigned if port @p 0 was bound.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    ADDR LocalAddr() const;
+
+    /**
+     * @brief Enable or disable the non-blocking mode.
+     *
+     * @details Batched accepting needs the non-blocking mode.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    void SetNonBlocking(bool enable) const;
+
     /**
      * @brief Accept a connection.
      *
@@ -60,22 +102,158 @@ public:
      */
     TcpSocket<ADDR> Accept();
 
+    /**
+     * @brief Accept pending connections until the queue is empty.
+     *
+     * @warning The server must be in the non-blocking mode.
+     *
+     * @param sockets
+     * A container receiving accepted connections in blocking mode.
+     * On platforms where they inherit the non-blocking mode of the server, the mode is cleared.
+     * @param max The maximum number of connections to accept.
+     * @return The number of accepted connections.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    std::size_t AcceptBatch(std::vector<TcpSocket<ADDR>>& sockets,
+                            std::size_t max = default_accept_batch);
+
+    /**
+     * @brief Accept a connection in a coroutine.
+     *
+     * @param stop_token A token cancelling the operation.
+     *
+     * @exception std::system_error The operation failed or has been cancelled.
+     */
+    Task<TcpSocket<ADDR>> AsyncAccept(std::stop_token stop_token = {});
+
+    /**
+     * @brief Accept connections in batches in a coroutine until it is cancelled.
+     *
+     * @details The server is switched to the non-blocking mode.
+     *
+     * @param on_accept A handler taking each accepted connection.
+     * @param stop_token A token cancelling the operation.
+     * @param max_batch The maximum number of connections to accept after each wake-up.
+     *
+     * @exception std::system_error The operation failed or has been cancelled.
+     */
+    Task<> AsyncServe(Handler on_accept, std::stop_token stop_token = {},
+                      std::size_t max_batch = default_accept_batch);
+
 private:
-    TcpSocket<ADDR> socket_{};
+    TcpSocket<ADDR> socket_{ invalid_socket };
+};
+
+/**
+ * @brief A TCP server sharded across several listening sockets bound to the same address.
+ *
+ * @details
+ * Each shard has its own worker thread and event loop,
+ * and the kernel spreads incoming connections across shards with @p SO_REUSEPORT,
+ * so accepting does not serialize on one socket.
+ * Each worker accepts connections in batches.
+ *
+ * @tparam ADDR An IP address.
+ */
+template <ValidIpAddr ADDR>
+class ShardedListener final {
+public:
+    using Handler = typename Listener<ADDR>::Handler;
+
+    /**
+     * @brief Bind the address and start a worker for each shard.
+     *
+     * @param addr An IP address.
+     * @param on_accept
+     * A handler taking each accepted connection.
+     * It is called on worker threads, so it must be thread-safe.
+     * @param shards The number of shards. @p 0 means one for each hardware thread.
+     *
+     * @exception std::invalid_argument
+     * More than one shard is requested but @p SO_REUSEPORT is not supported.
+     * @exception std::system_error The operation failed.
+     */
+    ShardedListener(const ADDR& addr, Handler on_accept,
+                    std::size_t shards = 0);
+
+    //! Stop and join all workers.
+    ~ShardedListener() noexcept;
+
+    ShardedListener(const ShardedListener&) = delete;
+
+    ShardedListener& operator=(const ShardedListener&) = delete;
+
+    //! Get the number of shards.
+    std::size_t Shards() const noexcept;
+
+    /**
+     * @brief Get the local IP address shared by all shards.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    ADDR LocalAddr() const;
+
+    //! Stop all workers and wait for them.
+    void Stop() noexcept;
+
+    /**
+     * @brief Get the error that has stopped a shard.
+     *
+     * @details A failed shard no longer accepts connections, while other shards keep running.
+     *
+     * @return The exception of the first failed shard, or an empty pointer if none has failed.
+     */
+    std::exception_ptr Error() const noexcept;
+
+private:
+    //! Accept connections of a shard until the worker is stopped or fails.
+    void RunWorker(std::stop_token stop_token,
+                   Listener<ADDR>& listener) noexcept;
+
+    Task<> Serve(Listener<ADDR>& listener, std::stop_token stop_token);
+
+    //! Record the error of a failed shard.
+    void Fail(std::exception_ptr error) noexcept;
+
+    Handler on_accept_;
+
+    mutable std::mutex error_mutex_{};
+
+    std::exception_ptr error_{};
+
+    std::vector<Listener<ADDR>> listeners_{};
+
+    std::vector<std::jthread> workers_{};
 };
 
 
 template <ValidIpAddr ADDR>
-void Listener<ADDR>::Bind(const ADDR& addr) {
-    socket_.SetAddr(addr);
-    socket_.Bind();
+void Listener<ADDR>::Bind(const ADDR& addr, const bool reuse_port) {
+    TcpSocket<ADDR> socket{ addr };
+    if (addr.Version() == AF_INET6) {
+        socket.template SetOption<opt::V6Only>(false);
+    }
+
+    if (reuse_port) {
+#ifdef SO_REUSEPORT
+        socket.template SetOption<opt::ReusePort>(true);
+#else
+        throw std::invalid_argument{ "SO_REUSEPORT is not supported." };
+#endif  // SO_REUSEPORT
+    }
+
+    socket.SetAddr(addr);
+    socket.Bind();
+    socket_.Close();
+    socket_ = std::move(socket);
 }
 
 
 template <ValidIpAddr ADDR>
-void Listener<ADDR>::Listen() {
-    if (listen(socket_.ID(), SOMAXCONN) == SOCKET_ERROR) {
-        sys::ThrowWsaLastError();
+void Listener<ADDR>::Listen(const int backlog) {
+    if (listen(socket_.ID(), backlog) == socket_error) {
+        ThrowLastSocketError();
     }
 }
 
@@ -86,17 +264,176 @@ void Listener<ADDR>::Close() noexcept {
 }
 
 template <ValidIpAddr ADDR>
-TcpSocket<ADDR> Listener<ADDR>::Accept() {
-    typename ADDR::RawType addr{};
-    int size{ sizeof(addr) };
+SocketId Listener<ADDR>::ID() const noexcept {
+    return socket_.ID();
+}
 
-    if (const auto new_id{
-            accept(socket_.ID(), reinterpret_cast<sockaddr*>(&addr), &size) };
-        new_id != INVALID_SOCKET) {
+template <ValidIpAddr ADDR>
+ADDR Listener<ADDR>::LocalAddr() const {
+    return socket_.LocalAddr();
+}
+
+template <ValidIpAddr ADDR>
+void Listener<ADDR>::SetNonBlocking(const bool enable) const {
+    socket_.SetNonBlocking(enable);
+}
+
+template <ValidIpAddr ADDR>
+TcpSocket<ADDR> Listener<ADDR>::Accept() {
+    if (const auto new_id{ AcceptSocket(socket_.ID()) };
+        new_id != invalid_socket) {
         return { new_id };
     } else {
-        sys::ThrowWsaLastError();
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+std::size_t Listener<ADDR>::AcceptBatch(std::vector<TcpSocket<ADDR>>& sockets,
+                                        const std::size_t max) {
+    std::size_t count{ 0 };
+    while (count != max) {
+        if (const auto new_id{ AcceptSocket(socket_.ID()) };
+            new_id != invalid_socket) {
+            sockets.emplace_back(new_id);
+#ifndef __linux__
+            // Accepted sockets inherit the non-blocking mode on Windows and BSD.
+            sockets.back().SetNonBlocking(false);
+#endif  // __linux__
+            ++count;
+        } else if (LastSocketErrorWouldBlock()) {
+            break;
+        } else if (!LastSocketErrorAborted()) {
+            ThrowLastSocketError();
+        }
+    }
+
+    return count;
+}
+
+
+template <ValidIpAddr ADDR>
+Task<TcpSocket<ADDR>> Listener<ADDR>::AsyncAccept(
+    const std::stop_token stop_token) {
+    co_await Executor::Current().Readable(socket_.ID(), stop_token);
+    co_return Accept();
+}
+
+template <ValidIpAddr ADDR>
+Task<> Listener<ADDR>::AsyncServe(const Handler on_accept,
+                                  const std::stop_token stop_token,
+                                  const std::size_t max_batch) {
+    SetNonBlocking(true);
+
+    std::vector<TcpSocket<ADDR>> sockets{};
+    sockets.reserve(max_batch);
+    while (true) {
+        co_await Executor::Current().Readable(socket_.ID(), stop_token);
+
+        // Connections left by a full batch keep the socket readable.
+        AcceptBatch(sockets, max_batch);
+        for (auto& socket : sockets) {
+            on_accept(std::move(socket));
+        }
+
+        sockets.clear();
+    }
+}
+
+
+template <ValidIpAddr ADDR>
+ShardedListener<ADDR>::ShardedListener(const ADDR& addr, Handler on_accept,
+                                       std::size_t shards) :
+    on_accept_{ std::move(on_accept) } {
+    if (shards == 0) {
+        shards = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    // Later shards bind the port assigned to the first one.
+    listeners_.resize(shards);
+    for (auto& listener : listeners_) {
+        listener.Bind(&listener == &listeners_.front()
+                          ? addr
+                          : listeners_.front().LocalAddr(),
+                      shards > 1);
+        listener.Listen();
+    }
+
+    workers_.reserve(shards);
+    for (auto& listener : listeners_) {
+        workers_.emplace_back(
+            [this, &listener](const std::stop_token stop_token) noexcept {
+                RunWorker(stop_token, listener);
+            });
+    }
+}
+
+template <ValidIpAddr ADDR>
+ShardedListener<ADDR>::~ShardedListener() noexcept {
+    Stop();
+}
+
+template <ValidIpAddr ADDR>
+std::size_t ShardedListener<ADDR>::Shards() const noexcept {
+    return listeners_.size();
+}
+
+template <ValidIpAddr ADDR>
+ADDR ShardedListener<ADDR>::LocalAddr() const {
+    return listeners_.front().LocalAddr();
+}
+
+template <ValidIpAddr ADDR>
+void ShardedListener<ADDR>::Stop() noexcept {
+    // Pending accepts are cancelled and each worker stops its event loop.
+    for (auto& worker : workers_) {
+        worker.request_stop();
+    }
+
+    workers_.clear();
+}
+
+template <ValidIpAddr ADDR>
+std::exception_ptr ShardedListener<ADDR>::Error() const noexcept {
+    const std::lock_guard lock{ error_mutex_ };
+    return error_;
+}
+
+template <ValidIpAddr ADDR>
+void ShardedListener<ADDR>::RunWorker(const std::stop_token stop_token,
+                                      Listener<ADDR>& listener) noexcept {
+    try {
+        Reactor reactor{};
+        Executor executor{ reactor };
+        executor.Spawn(Serve(listener, stop_token));
+        executor.Run();
+    } catch (...) {
+        Fail(std::current_exception());
+    }
+}
+
+template <ValidIpAddr ADDR>
+Task<> ShardedListener<ADDR>::Serve(Listener<ADDR>& listener,
+                                    const std::stop_token stop_token) {
+    auto& executor{ Executor::Current() };
+    try {
+        co_await listener.AsyncServe(on_accept_, stop_token);
+    } catch (...) {
+        // Serving only ends with an exception, which is expected after a stop request.
+        if (!stop_token.stop_requested()) {
+            Fail(std::current_exception());
+        }
+    }
+
+    executor.Stop();
+}
+
+template <ValidIpAddr ADDR>
+void ShardedListener<ADDR>::Fail(const std::exception_ptr error) noexcept {
+    const std::lock_guard lock{ error_mutex_ };
+    if (!error_) {
+        error_ = error;
     }
 }
 
-}  // namespace net
\ No newline at end of file
+}  // namespace net
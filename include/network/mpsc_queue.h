@@ -0,0 +1,145 @@
+/**
+ * @file mpsc_queue.h
+ * @brief The lock-free multi-producer single-consumer queue.
+ *
+ * @details
+ * A queue is a bounded ring of slots, each with a sequence number telling whose turn it is.
+ * Producers claim slots by advancing the tail with compare-and-swap,
+ * and publish an element by bumping the sequence number of its slot.
+ * The consumer takes published elements in order without atomic read-modify-write operations.
+ * Slots are on their own cache lines, so producers filling neighbouring slots do not contend.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "spsc_queue.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+
+namespace net {
+
+/**
+ * @brief The lock-free multi-producer single-consumer queue.
+ *
+ * @details
+ * @p TryPush can be called by any thread, but @p TryPop must only be called by one thread.
+ *
+ * @tparam T A trivially copyable element.
+ * @tparam CAPACITY The maximum number of elements, which must be a power of two.
+ */
+template <typename T, std::size_t CAPACITY>
+class MpscQueue final {
+public:
+    static_assert(std::has_single_bit(CAPACITY),
+                  "The capacity must be a power of two.");
+    static_assert(std::is_trivially_copyable_v<T>
+                  && std::is_default_constructible_v<T>);
+
+    //! The maximum number of elements.
+    static constexpr std::size_t capacity{ CAPACITY };
+
+    MpscQueue() noexcept {
+        for (std::size_t i{ 0 }; i != capacity; ++i) {
+            slots_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Append an element on any thread.
+     *
+     * @param val An element.
+     * @return Whether it has been appended, or @p false if the queue is full.
+     */
+    bool TryPush(const T& val) noexcept {
+        auto tail{ tail_.load(std::memory_order_relaxed) };
+        while (true) {
+            auto& slot{ slots_[tail & (capacity - 1)] };
+            const auto seq{ slot.seq.load(std::memory_order_acquire) };
+            const auto lag{ static_cast<std::intptr_t>(seq)
+                            - static_cast<std::intptr_t>(tail) };
+            if (lag == 0) {
+                // The slot is free in this round. Claim it.
+                if (tail_.compare_exchange_weak(tail, tail + 1,
+                                                std::memory_order_relaxed)) {
+                    slot.val = val;
+                    slot.seq.store(tail + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                // The slot still holds an element of the previous round.
+                return false;
+            } else {
+                // Another producer has claimed the slot.
+                tail = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Take the oldest element on the consumer thread.
+     *
+     * @return An element, or an empty value if the oldest claimed slot has not been published.
+     */
+    std::optional<T> TryPop() noexcept {
+        const auto head{ head_.load(std::memory_order_relaxed) };
+        auto& slot{ slots_[head & (capacity - 1)] };
+        if (slot.seq.load(std::memory_order_acquire) != head + 1) {
+            return std::nullopt;
+        }
+
+        const auto val{ slot.val };
+        slot.seq.store(head + capacity, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
+        return val;
+    }
+
+    //! Get the number of claimed slots, which may be outdated when it returns.
+    std::size_t Size() const noexcept {
+        // The head is loaded first, so it never passes the tail.
+        const auto head{ head_.load(std::memory_order_acquire) };
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    //! Check if the queue is empty, which may be outdated when it returns.
+    bool Empty() const noexcept {
+        return Size() == 0;
+    }
+
+private:
+    struct alignas(cache_line_size) Slot {
+        //! The tail position that may claim the slot, or the next one if it has been published.
+        std::atomic<std::size_t> seq;
+
+        T val;
+    };
+
+    //! The index of the next element to take, written by the consumer.
+    alignas(cache_line_size) std::atomic<std::size_t> head_{ 0 };
+
+    //! The index of the next slot to claim, written by producers.
+    alignas(cache_line_size) std::atomic<std::size_t> tail_{ 0 };
+
+    std::array<Slot, capacity> slots_{};
+};
+
+}  // namespace net
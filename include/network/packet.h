@@ -14,56 +14,328 @@
 
 #pragma once
 
+#include "async.h"
+#include "buffer_pool.h"
+#include "byte_order.h"
 #include "socket/tcp.h"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
-#include <memory>
 #include <span>
-#include <vector>
+#include <stdexcept>
+#include <stop_token>
 
 
 namespace net {
 
-//! The header of a network packet.
-struct alignas(std::int32_t) Header {
+//! The version of the header layout.
+inline constexpr std::uint8_t header_version{ 1 };
+
+//! Flags of a packet header.
+enum class HeaderFlag : std::uint8_t {
+    //! @p Header::checksum holds the CRC32C checksum of the following data.
+    Checksum = 1 << 0
+};
+
+/**
+ * @brief The header of a network packet.
+ *
+ * @details
+ * All fields have fixed widths. On the wire they are stored in little-endian order,
+ * so 32-bit and 64-bit peers, relays and analyzers on hosts of either order read the same layout.
+ * Applications fill in a header in the native order, and @p Seal converts it.
+ * Received headers are read by @p LoadHeader or @p PacketView.
+ */
+struct alignas(std::uint32_t) Header {
     //! The size of the following data.
-    std::size_t size;
+    std::uint32_t size;
+
+    //! The version of the layout.
+    std::uint8_t version{ header_version };
+
+    //! Flags as a bit set of @p HeaderFlag.
+    std::uint8_t flags{ 0 };
+
+    //! The type defined by the application.
+    std::uint16_t type{ 0 };
+
+    //! The sequence number defined by the application.
+    std::uint32_t seq{ 0 };
+
+    //! The checksum of the following data if @p HeaderFlag::Checksum is set.
+    std::uint32_t checksum{ 0 };
 };
 
-//! The network packet.
+static_assert(sizeof(Header) == 16);
+
+/**
+ * @brief Read a header stored in little-endian order.
+ *
+ * @param data At least the size of a header, in a buffer of any alignment.
+ */
+inline Header LoadHeader(const std::span<const std::byte> data) noexcept {
+    assert(data.size_bytes() >= sizeof(Header));
+    return { .size{ LoadLittle<std::uint32_t>(data.data()
+                                              + offsetof(Header, size)) },
+             .version{ static_cast<std::uint8_t>(
+                 data[offsetof(Header, version)]) },
+             .flags{ static_cast<std::uint8_t>(data[offsetof(Header, flags)]) },
+             .type{ LoadLittle<std::uint16_t>(data.data()
+                                              + offsetof(Header, type)) },
+             .seq{ LoadLittle<std::uint32_t>(data.data()
+                                             + offsetof(Header, seq)) },
+             .checksum{ LoadLittle<std::uint32_t>(
+                 data.data() + offsetof(Header, checksum)) } };
+}
+
+/**
+ * @brief Store a header in little-endian order.
+ *
+ * @param header A header.
+ * @param data At least the size of a header, in a buffer of any alignment.
+ */
+inline void StoreHeader(const Header& header,
+                        const std::span<std::byte> data) noexcept {
+    assert(data.size_bytes() >= sizeof(Header));
+    StoreLittle(data.data() + offsetof(Header, size), header.size);
+    data[offsetof(Header, version)] = static_cast<std::byte>(header.version);
+    data[offsetof(Header, flags)] = static_cast<std::byte>(header.flags);
+    StoreLittle(data.data() + offsetof(Header, type), header.type);
+    StoreLittle(data.data() + offsetof(Header, seq), header.seq);
+    StoreLittle(data.data() + offsetof(Header, checksum), header.checksum);
+}
+
+/**
+ * @brief Fill in the size and the checksum of a packet, and store its header in little-endian order.
+ *
+ * @details
+ * The checksum is only computed if @p HeaderFlag::Checksum is set.
+ * The header is converted in place, so a sealed packet must not be sealed again.
+ *
+ * @param head The beginning of a packet, starting with a header in the native order.
+ * @param payload Payload buffers following the head.
+ *
+ * @exception std::length_error The packet is too large.
+ */
+void Seal(std::span<std::byte> head,
+          std::span<const std::span<const std::byte>> payload = {});
+
+/**
+ * @brief Check the header of a received packet.
+ *
+ * @param packet A packet including its header, in a buffer of any alignment.
+ *
+ * @exception std::invalid_argument The version is unsupported, or the size or the checksum is mismatched.
+ */
+void Verify(std::span<const std::byte> packet);
+
+/**
+ * @brief Receive data until a buffer is full.
+ *
+ * @tparam SOCKET A stream socket.
+ * @param socket A socket.
+ * @param buffer A buffer.
+ *
+ * @exception std::runtime_error The connection has been closed.
+ * @exception std::system_error The operation failed.
+ */
+template <StreamSocket SOCKET>
+void RecvAll(SOCKET& socket, std::span<std::byte> buffer) {
+    while (!buffer.empty()) {
+        const auto received{ socket.Recv(buffer) };
+        if (received == 0) {
+            throw std::runtime_error{ "The connection has been closed." };
+        }
+
+        buffer = buffer.subspan(received);
+    }
+}
+
+/**
+ * @brief Receive data until a buffer is full in a coroutine.
+ *
+ * @tparam SOCKET A stream socket supporting coroutines.
+ * @param socket A socket.
+ * @param buffer A buffer.
+ * @param stop_token A token cancelling the operation.
+ *
+ * @exception std::runtime_error The connection has been closed.
+ * @exception std::system_error The operation failed or has been cancelled.
+ */
+template <AsyncStreamSocket SOCKET>
+Task<> AsyncRecvAll(SOCKET& socket, std::span<std::byte> buffer,
+                    const std::stop_token stop_token = {}) {
+    while (!buffer.empty()) {
+        const auto received{ co_await socket.AsyncRecv(buffer, stop_token) };
+        if (received == 0) {
+            throw std::runtime_error{ "The connection has been closed." };
+        }
+
+        buffer = buffer.subspan(received);
+    }
+}
+
+/**
+ * @brief Get the size of a packet from its header.
+ *
+ * @param header A header.
+ * @param max_size The maximum size of a packet, including its header.
+ * @return The packet size, including the header.
+ *
+ * @exception std::runtime_error The packet is too large.
+ */
+inline std::size_t PacketSize(const Header& header,
+                              const std::size_t max_size) {
+    if (max_size < sizeof(Header) || header.size > max_size - sizeof(Header)) {
+        throw std::runtime_error{ "The packet is too large." };
+    }
+
+    return sizeof(Header) + header.size;
+}
+
+/**
+ * @brief The network packet.
+ *
+ * @details
+ * Small packets are stored inline without heap allocations.
+ * Larger ones are stored in blocks from the shared @p BufferPool.
+ */
 class Packet {
 public:
+    //! The maximum number of payload buffers sent with a header.
+    static constexpr std::size_t max_payload_buffers{ max_send_buffers - 1 };
+
+    //! The size of inline storage, which holds every game event.
+    static constexpr std::size_t inline_capacity{ 64 };
+
+    //! The default maximum size of a received packet, including its header.
+    static constexpr std::size_t default_max_size{ 64 * 1024 };
+
+    Packet() noexcept = default;
+
+    Packet(const Packet& that);
+
+    Packet(Packet&& that) noexcept;
+
+    Packet& operator=(const Packet& that);
+
+    Packet& operator=(Packet&& that) noexcept;
+
+    ~Packet() noexcept;
+
     /**
      * @brief Receive a packet
      *
-     * @tparam ADDR A valid IP address.
+     * @details
+     * It receives the header and the body with separate calls.
+     * Use @p StreamReader to receive many packets with one call,
+     * or @p RecvArena to receive them without allocations.
+     *
+     * @tparam SOCKET A stream socket.
      * @param socket A socket.
+     * @param max_size The maximum size of a packet, including its header.
+     * Larger packets are rejected before any memory is allocated for them.
      * @return A packet.
+     *
+     * @exception std::runtime_error The connection has been closed or the packet is too large.
+     * @exception std::system_error The operation failed.
+     * @exception std::invalid_argument The header is invalid.
      */
-    template <ValidIpAddr ADDR>
-    static Packet Recv(const TcpSocket<ADDR>& socket) {
+    template <StreamSocket SOCKET>
+    static Packet Recv(SOCKET& socket,
+                       const std::size_t max_size = default_max_size) {
         Packet pkg{};
 
-        Header header{};
-        socket.Recv({ reinterpret_cast<std::byte*>(&header), sizeof(header) });
-        pkg.Write({ reinterpret_cast<std::byte*>(&header), sizeof(header) });
-
-        std::unique_ptr<std::byte[]> body{ new std::byte[header.size]{} };
-        socket.Recv({ body.get(), header.size });
-        pkg.Write({ body.get(), header.size });
+        std::array<std::byte, sizeof(Header)> head{};
+        RecvAll(socket, head);
+        const auto header{ LoadHeader(head) };
+        PacketSize(header, max_size);
+        pkg.Write(head);
+        RecvAll(socket, pkg.Extend(header.size));
+        Verify(pkg.Read());
         return pkg;
     }
 
+    /**
+     * @brief Receive a packet in a coroutine.
+     *
+     * @tparam SOCKET A stream socket supporting coroutines.
+     * @param socket A socket.
+     * @param stop_token A token cancelling the operation.
+     * @param max_size The maximum size of a packet, including its header.
+     * @return A packet.
+     *
+     * @exception std::runtime_error The connection has been closed or the packet is too large.
+     * @exception std::system_error The operation failed or has been cancelled.
+     * @exception std::invalid_argument The header is invalid.
+     */
+    template <AsyncStreamSocket SOCKET>
+    static Task<Packet> AsyncRecv(SOCKET& socket,
+                                  const std::stop_token stop_token = {},
+                                  const std::size_t max_size
+                                  = default_max_size) {
+        Packet pkg{};
+
+        std::array<std::byte, sizeof(Header)> head{};
+        co_await AsyncRecvAll(socket, head, stop_token);
+        const auto header{ LoadHeader(head) };
+        PacketSize(header, max_size);
+        pkg.Write(head);
+        co_await AsyncRecvAll(socket, pkg.Extend(header.size), stop_token);
+        Verify(pkg.Read());
+        co_return pkg;
+    }
+
     /**
      * @brief Send the packet.
      *
-     * @tparam ADDR An IP address.
+     * @tparam SOCKET A stream socket.
+     * @param socket A socket.
+     */
+    template <StreamSocket SOCKET>
+    void Send(SOCKET& socket) {
+        socket.Send(Read());
+    }
+
+    /**
+     * @brief Send a header and payload without copying them into a packet.
+     *
+     * @details
+     * The header is sealed by @p Seal, so its size covers data following the base @p Header,
+     * which includes the rest of @p header and the payload.
+     * The base @p Header is left in little-endian order.
+     * Data is sent by a single vectored call unless the socket accepts only a part of it.
+     *
+     * @tparam SOCKET A stream socket supporting vectored sends.
+     * @tparam HEADER A header derived from @p Header.
      * @param socket A socket.
+     * @param header A header.
+     * @param payload Payload buffers following the header.
+     *
+     * @exception std::invalid_argument There are too many payload buffers.
+     * @exception std::length_error The packet is too large.
+     * @exception std::system_error The operation failed.
      */
-    template <ValidIpAddr ADDR>
-    void Send(const TcpSocket<ADDR>& socket) {
-        socket.Send(buffer_);
+    template <VectoredStreamSocket SOCKET, std::derived_from<Header> HEADER>
+    static void Send(SOCKET& socket, HEADER& header,
+                     const std::span<const std::span<const std::byte>> payload
+                     = {}) {
+        if (payload.size() > max_payload_buffers) {
+            throw std::invalid_argument{ "There are too many payload buffers." };
+        }
+
+        Seal({ reinterpret_cast<std::byte*>(&header), sizeof(header) },
+             payload);
+
+        std::array<std::span<const std::byte>, max_send_buffers> buffers{};
+        buffers[0] = { reinterpret_cast<const std::byte*>(&header),
+                       sizeof(header) };
+        std::ranges::copy(payload, buffers.begin() + 1);
+        SendAll(socket, std::span{ buffers }.first(payload.size() + 1));
     }
 
     /**
@@ -72,17 +344,54 @@ public:
      * @param data A buffer.
      * @return The packet size.
      */
-    std::size_t Write(std::span<const std::byte> data) noexcept;
+    std::size_t Write(std::span<const std::byte> data);
 
     /**
      * @brief Read data.
      *
      * @return A buffer.
      */
-    std::span<const std::byte> Read() noexcept;
+    std::span<const std::byte> Read() const noexcept;
 
 private:
-    std::vector<std::byte> buffer_{};
+    //! Get the storage in use, either inline or pooled.
+    std::span<std::byte> Storage() noexcept;
+
+    std::span<const std::byte> Storage() const noexcept;
+
+    //! Make sure the storage can hold data of a size.
+    void Reserve(std::size_t capacity);
+
+    //! Append uninitialized data and get it.
+    std::span<std::byte> Extend(std::size_t size);
+
+    //! Return the pooled block and go back to inline storage.
+    void ReleaseBlock() noexcept;
+
+    //! Send buffers until all data has been sent.
+    template <VectoredStreamSocket SOCKET>
+    static void SendAll(SOCKET& socket,
+                        std::span<std::span<const std::byte>> buffers) {
+        while (!buffers.empty()) {
+            auto sent{ socket.Send(
+                std::span<const std::span<const std::byte>>{ buffers }) };
+            while (!buffers.empty() && sent >= buffers.front().size_bytes()) {
+                sent -= buffers.front().size_bytes();
+                buffers = buffers.subspan(1);
+            }
+
+            if (!buffers.empty()) {
+                buffers.front() = buffers.front().subspan(sent);
+            }
+        }
+    }
+
+    alignas(Header) std::array<std::byte, inline_capacity> inline_{};
+
+    //! A block from the pool, or empty if inline storage is used.
+    std::span<std::byte> block_{};
+
+    std::size_t size_{ 0 };
 };
 
 }  // namespace net
\ No newline at end of file
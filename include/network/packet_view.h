@@ -0,0 +1,140 @@
+/**
+ * @file packet_view.h
+ * @brief The typed view of a received packet.
+ *
+ * @details
+ * A view checks the size of a packet once and reads its fields in place.
+ * Fields are copied out with @p std::memcpy,
+ * so a buffer of any alignment can be read without breaking strict aliasing.
+ * Compilers turn each copy into a plain load.
+ * Fields of the base @p Header are converted from little-endian order,
+ * while others are read as the application stored them.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "packet.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace net {
+
+//! A packet layout that can be read from raw bytes.
+template <typename T>
+concept PacketLayout = std::derived_from<T, Header>
+                       && std::is_trivially_copyable_v<T>
+                       && std::is_default_constructible_v<T>;
+
+/**
+ * @brief The typed view of a packet in a receive buffer.
+ *
+ * @details
+ * A view does not own data. The buffer must outlive it.
+ *
+ * @tparam T A packet layout.
+ */
+template <PacketLayout T>
+class PacketView final {
+public:
+    /**
+     * @brief Create a view.
+     *
+     * @param data A packet including its header.
+     *
+     * @exception std::invalid_argument The packet is smaller than @p T.
+     */
+    explicit PacketView(const std::span<const std::byte> data) :
+        data_{ data } {
+        if (data_.size_bytes() < sizeof(T)) {
+            throw std::invalid_argument{ "The packet is too small." };
+        }
+    }
+
+    /**
+     * @brief Try to create a view.
+     *
+     * @param data A packet including its header.
+     * @return A view, or an empty value if the packet is smaller than @p T.
+     */
+    static std::optional<PacketView> From(
+        const std::span<const std::byte> data) noexcept {
+        if (data.size_bytes() < sizeof(T)) {
+            return std::nullopt;
+        }
+
+        return PacketView{ data, Checked{} };
+    }
+
+    /**
+     * @brief Read a field.
+     *
+     * @param field A pointer to a data member of @p T or one of its bases.
+     * @return A copy of the field.
+     */
+    template <typename FIELD, typename CLASS>
+        requires std::is_base_of_v<CLASS, T>
+                 && std::is_trivially_copyable_v<FIELD>
+    FIELD Get(FIELD CLASS::*const field) const noexcept {
+        FIELD val;
+        std::memcpy(&val, data_.data() + Offset(field), sizeof(val));
+        if constexpr (std::is_same_v<CLASS, Header>) {
+            val = LittleEndian(val);
+        }
+
+        return val;
+    }
+
+    //! Copy the whole packet out, with its base @p Header in the native order.
+    T Load() const noexcept {
+        T val;
+        std::memcpy(&val, data_.data(), sizeof(val));
+        static_cast<Header&>(val) = LoadHeader(data_);
+        return val;
+    }
+
+    //! Get the bytes following @p T, such as a variable-length payload.
+    std::span<const std::byte> Tail() const noexcept {
+        return data_.subspan(sizeof(T));
+    }
+
+    //! Get the whole packet.
+    std::span<const std::byte> Bytes() const noexcept {
+        return data_;
+    }
+
+private:
+    struct Checked {};
+
+    PacketView(const std::span<const std::byte> data, Checked) noexcept :
+        data_{ data } {}
+
+    //! Get the offset of a field, which is folded into a constant by compilers.
+    template <typename FIELD, typename CLASS>
+    static std::size_t Offset(FIELD CLASS::*const field) noexcept {
+        const T probe{};
+        const CLASS& base{ probe };
+        return static_cast<std::size_t>(
+            reinterpret_cast<const std::byte*>(&(base.*field))
+            - reinterpret_cast<const std::byte*>(&probe));
+    }
+
+    std::span<const std::byte> data_;
+};
+
+}  // namespace net
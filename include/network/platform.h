@@ -0,0 +1,125 @@
+/**
+ * @file platform.h
+ * @brief The platform abstraction of socket libraries.
+ *
+ * @details
+ * Windows uses Winsock and other platforms use BSD sockets.
+ * Other network headers should include this file instead of system headers.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#ifdef _WIN32
+    #define _WINSOCKAPI_
+
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif  // _WIN32
+
+
+namespace net {
+
+#ifdef _WIN32
+//! The low-level socket handle.
+using SocketId = SOCKET;
+
+//! The size type of socket addresses.
+using SockLen = int;
+
+//! The invalid socket handle.
+inline constexpr SocketId invalid_socket{ INVALID_SOCKET };
+
+//! The default flags of @p send.
+inline constexpr int send_flags{ 0 };
+#else
+//! The low-level socket handle.
+using SocketId = int;
+
+//! The size type of socket addresses.
+using SockLen = socklen_t;
+
+//! The invalid socket handle.
+inline constexpr SocketId invalid_socket{ -1 };
+
+//! The default flags of @p send. A closed peer should not raise @p SIGPIPE.
+inline constexpr int send_flags{ MSG_NOSIGNAL };
+#endif  // _WIN32
+
+//! The return value of socket functions when they fail.
+inline constexpr int socket_error{ -1 };
+
+/**
+ * @brief Close a low-level socket handle.
+ *
+ * @param id A socket handle.
+ */
+void CloseSocket(SocketId id) noexcept;
+
+/**
+ * @brief Throw a @p std::system_error exception containing the last socket error.
+ *
+ * @details
+ * It is the Windows Sockets last-error on Windows and @p errno on other platforms.
+ */
+[[noreturn]] void ThrowLastSocketError();
+
+/**
+ * @brief Enable or disable the non-blocking mode of a socket.
+ *
+ * @param id A socket handle.
+ * @param enable Whether to enable the non-blocking mode.
+ *
+ * @exception std::system_error The operation failed.
+ */
+void SetNonBlocking(SocketId id, bool enable);
+
+/**
+ * @brief Check if the last socket error means a non-blocking operation would block or is in progress.
+ */
+bool LastSocketErrorWouldBlock() noexcept;
+
+/**
+ * @brief Get and clear the pending error of a socket.
+ *
+ * @param id A socket handle.
+ * @return The error code, or @p 0 if there is no error.
+ *
+ * @exception std::system_error The operation failed.
+ */
+int TakeSocketError(SocketId id);
+
+/**
+ * @brief Accept a pending connection of a listening socket.
+ *
+ * @details
+ * It uses @p accept4 on Linux, so the new handle is closed on @p exec
+ * without another system call.
+ *
+ * @param id A listening socket handle.
+ * @return A new socket handle, or @p invalid_socket if the operation failed.
+ */
+SocketId AcceptSocket(SocketId id) noexcept;
+
+/**
+ * @brief Check if the last socket error means a pending connection was aborted or the call was interrupted.
+ *
+ * @details Such errors only affect one connection, so the listener can keep accepting.
+ */
+bool LastSocketErrorAborted() noexcept;
+
+}  // namespace net
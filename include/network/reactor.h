@@ -0,0 +1,236 @@
+/**
+ * @file reactor.h
+ * @brief The readiness-based event loop.
+ *
+ * @details
+ * It uses @p epoll on Linux and @p WSAPoll on Windows.
+ * A single thread can wait for many sockets and timers, and other threads can wake it up at any time.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "platform.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace net {
+
+//! Readiness events of a socket.
+enum class Event : std::uint32_t {
+    None = 0,
+
+    //! The socket can be read or a connection can be accepted.
+    Read = 1 << 0,
+
+    //! The socket can be written.
+    Write = 1 << 1,
+
+    //! An error occurred or the peer hung up.
+    Error = 1 << 2
+};
+
+constexpr Event operator|(const Event lhs, const Event rhs) noexcept {
+    return static_cast<Event>(static_cast<std::uint32_t>(lhs)
+                              | static_cast<std::uint32_t>(rhs));
+}
+
+constexpr Event operator&(const Event lhs, const Event rhs) noexcept {
+    return static_cast<Event>(static_cast<std::uint32_t>(lhs)
+                              & static_cast<std::uint32_t>(rhs));
+}
+
+//! Check if an event set contains an event.
+constexpr bool HasEvent(const Event events, const Event event) noexcept {
+    return (events & event) != Event::None;
+}
+
+/**
+ * @brief The readiness-based event loop.
+ *
+ * @details
+ * Except @p Post and @p Stop, methods must be called from the thread running the loop,
+ * or before the loop starts.
+ */
+class Reactor final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! The handler of socket events.
+    using Handler = std::function<void(Event)>;
+
+    //! The handler of timers and posted tasks.
+    using Task = std::function<void()>;
+
+    //! The timer ID.
+    using TimerId = std::uint64_t;
+
+    /**
+     * @brief Create an event loop.
+     *
+     * @exception std::system_error The initialization failed.
+     */
+    Reactor();
+
+    ~Reactor() noexcept;
+
+    Reactor(const Reactor&) = delete;
+
+    Reactor& operator=(const Reactor&) = delete;
+
+    /**
+     * @brief Start to watch a socket.
+     *
+     * @param id A socket handle.
+     * @param events Interested events. @p Event::Error is always reported.
+     * @param handler A handler called when any event occurs.
+     *
+     * @exception std::invalid_argument The socket has been watched.
+     * @exception std::system_error The operation failed.
+     */
+    void Watch(SocketId id, Event events, Handler handler);
+
+    /**
+     * @brief Change interested events of a watched socket.
+     *
+     * @exception std::invalid_argument The socket is not watched.
+     * @exception std::system_error The operation failed.
+     */
+    void Modify(SocketId id, Event events);
+
+    /**
+     * @brief Stop watching a socket.
+     *
+     * @details It can be called from a handler, including the socket's own one.
+     */
+    void Unwatch(SocketId id) noexcept;
+
+    /**
+     * @brief Add a timer.
+     *
+     * @param delay The delay before the first expiry.
+     * @param task A task called when the timer expires.
+     * @param period The period of a repeating timer, or zero for a one-shot timer.
+     * @return The timer ID.
+     */
+    TimerId AddTimer(Clock::duration delay, Task task,
+                     Clock::duration period = Clock::duration::zero());
+
+    /**
+     * @brief Cancel a timer.
+     *
+     * @details It can be called from a task, including the timer's own one.
+     */
+    void CancelTimer(TimerId id) noexcept;
+
+    /**
+     * @brief Run a task on the loop thread. It is thread-safe.
+     *
+     * @param task A task.
+     */
+    void Post(Task task);
+
+    /**
+     * @brief Run the loop until @p Stop is called.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    void Run();
+
+    /**
+     * @brief Wait for events once and dispatch them.
+     *
+     * @param timeout The maximum waiting time. It waits forever if it is empty.
+     * @return The number of dispatched handlers, timers and tasks.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    std::size_t RunOnce(std::optional<Clock::duration> timeout);
+
+    //! Stop the loop and wake it up. It is thread-safe.
+    void Stop() noexcept;
+
+    //! Check if the loop has been stopped.
+    bool Stopped() const noexcept;
+
+private:
+    //! The maximum number of events returned by one wait.
+    static constexpr std::size_t max_events{ 64 };
+
+    struct Watcher {
+        Event events;
+        Handler handler;
+    };
+
+    struct Timer {
+        Clock::duration period;
+        Task task;
+    };
+
+    //! Wake up the waiting thread.
+    void Wakeup() noexcept;
+
+    //! Consume all pending wake-up signals.
+    void DrainWakeup() noexcept;
+
+    //! Wait for socket events and dispatch them.
+    std::size_t Poll(std::optional<Clock::duration> timeout);
+
+    //! Call the handler of a socket if it is still watched.
+    std::size_t Dispatch(SocketId id, Event events);
+
+    //! Run posted tasks.
+    std::size_t RunTasks();
+
+    //! Run expired timers.
+    std::size_t RunTimers();
+
+    //! Get the waiting time before the next timer expires.
+    std::optional<Clock::duration> NextTimeout(
+        std::optional<Clock::duration> timeout) const noexcept;
+
+#ifdef _WIN32
+    //! A UDP socket connected to itself, used to wake up @p WSAPoll.
+    SocketId wakeup_{ invalid_socket };
+#else
+    int epoll_{ -1 };
+
+    //! An @p eventfd used to wake up @p epoll_wait.
+    int wakeup_{ -1 };
+#endif  // _WIN32
+
+    std::unordered_map<SocketId, Watcher> watchers_{};
+
+    std::map<std::pair<Clock::time_point, TimerId>, Timer> timers_{};
+
+    std::unordered_map<TimerId, Clock::time_point> timer_deadlines_{};
+
+    TimerId next_timer_id_{ 0 };
+
+    std::mutex tasks_mtx_{};
+
+    std::vector<Task> tasks_{};
+
+    std::atomic_bool stopped_{ false };
+};
+
+}  // namespace net
@@ -0,0 +1,211 @@
+/**
+ * @file recv_arena.h
+ * @brief The bounded receive arena of a connection.
+ *
+ * @details
+ * An arena allocates one buffer of a fixed budget when it is created,
+ * and carves received packets out of it as a ring.
+ * A packet is recycled when its frame is destroyed, usually after it has been processed,
+ * so memory used for receiving stays constant and no allocations are made per packet.
+ * The size claimed by a header is checked before any data is received into the arena,
+ * so a peer cannot make the receiver allocate more than the budget.
+ * A @p StreamReader is bounded in the same way when its capacity covers the largest packet,
+ * but its packets are only valid until the next read, so an arena suits receivers keeping packets longer.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "async.h"
+#include "packet.h"
+#include "socket/tcp.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stop_token>
+
+
+namespace net {
+
+/**
+ * @brief The bounded receive arena of a connection.
+ *
+ * @details
+ * Frames are allocated at the head of the ring and reclaimed from its tail.
+ * They can be released in any order, but space is only reclaimed up to the oldest live frame.
+ * An arena is not thread-safe.
+ */
+class RecvArena final {
+public:
+    //! The default budget of a connection.
+    static constexpr std::size_t default_budget{ 256 * 1024 };
+
+    //! The default maximum size of a frame, including its header.
+    static constexpr std::size_t default_max_frame_size{
+        Packet::default_max_size
+    };
+
+    //! A frame in an arena, which is released when it is destroyed.
+    class Frame final {
+    public:
+        Frame() noexcept = default;
+
+        Frame(Frame&& that) noexcept;
+
+        Frame& operator=(Frame&& that) noexcept;
+
+        ~Frame() noexcept;
+
+        Frame(const Frame&) = delete;
+
+        Frame& operator=(const Frame&) = delete;
+
+        //! Get data for writing.
+        std::span<std::byte> Data() const noexcept;
+
+        //! Get data for reading.
+        std::span<const std::byte> Read() const noexcept;
+
+        //! Release the frame to its arena.
+        void Release() noexcept;
+
+    private:
+        friend class RecvArena;
+
+        Frame(RecvArena& arena, std::span<std::byte> data) noexcept;
+
+        RecvArena* arena_{ nullptr };
+
+        std::span<std::byte> data_{};
+    };
+
+    /**
+     * @brief Create an arena.
+     *
+     * @param budget The total size of memory, including a small overhead per frame.
+     * @param max_frame_size The maximum size of a frame, including its header.
+     *
+     * @exception std::invalid_argument The budget cannot hold a frame of the maximum size,
+     * or the maximum size is smaller than a header.
+     */
+    explicit RecvArena(std::size_t budget = default_budget,
+                       std::size_t max_frame_size = default_max_frame_size);
+
+    RecvArena(const RecvArena&) = delete;
+
+    RecvArena& operator=(const RecvArena&) = delete;
+
+    /**
+     * @brief Allocate a frame.
+     *
+     * @param size The size.
+     * @return An uninitialized frame.
+     *
+     * @exception std::runtime_error The frame is too large or the budget has been used up.
+     */
+    Frame Allocate(std::size_t size);
+
+    /**
+     * @brief Receive a packet into a frame.
+     *
+     * @tparam SOCKET A stream socket.
+     * @param socket A socket.
+     * @return A frame holding the packet including its header.
+     *
+     * @exception std::runtime_error The connection has been closed, the packet is too large or the budget has been used up.
+     * @exception std::system_error The operation failed.
+     * @exception std::invalid_argument The header is invalid.
+     */
+    template <StreamSocket SOCKET>
+    Frame Recv(SOCKET& socket) {
+        std::array<std::byte, sizeof(Header)> head{};
+        RecvAll(socket, head);
+        auto frame{ Allocate(PacketSize(LoadHeader(head), max_frame_size_)) };
+        std::ranges::copy(head, frame.Data().begin());
+        RecvAll(socket, frame.Data().subspan(sizeof(head)));
+        Verify(frame.Read());
+        return frame;
+    }
+
+    /**
+     * @brief Receive a packet into a frame in a coroutine.
+     *
+     * @tparam SOCKET A stream socket supporting coroutines.
+     * @param socket A socket.
+     * @param stop_token A token cancelling the operation.
+     * @return A frame holding the packet including its header.
+     *
+     * @exception std::runtime_error The connection has been closed, the packet is too large or the budget has been used up.
+     * @exception std::system_error The operation failed or has been cancelled.
+     * @exception std::invalid_argument The header is invalid.
+     */
+    template <AsyncStreamSocket SOCKET>
+    Task<Frame> AsyncRecv(SOCKET& socket,
+                          const std::stop_token stop_token = {}) {
+        std::array<std::byte, sizeof(Header)> head{};
+        co_await AsyncRecvAll(socket, head, stop_token);
+        auto frame{ Allocate(PacketSize(LoadHeader(head), max_frame_size_)) };
+        std::ranges::copy(head, frame.Data().begin());
+        co_await AsyncRecvAll(socket, frame.Data().subspan(sizeof(head)),
+                              stop_token);
+        Verify(frame.Read());
+        co_return frame;
+    }
+
+    //! Get the total size of memory.
+    std::size_t Budget() const noexcept;
+
+    //! Get the maximum size of a frame.
+    std::size_t MaxFrameSize() const noexcept;
+
+    //! Get the size of memory that has not been reclaimed, including overheads.
+    std::size_t InUse() const noexcept;
+
+private:
+    //! The record before each frame in the ring.
+    struct Slot {
+        //! The size of the slot, including the record and padding.
+        std::uint32_t size;
+
+        //! Whether the frame has been released.
+        std::uint32_t released;
+    };
+
+    //! Get the size of the slot holding a frame.
+    static std::size_t SlotSize(std::size_t frame_size) noexcept;
+
+    //! Release a frame and reclaim released slots from the tail.
+    void Release(std::span<std::byte> data) noexcept;
+
+    //! Write a slot record at an offset.
+    void Mark(std::size_t offset, const Slot& slot) noexcept;
+
+    std::size_t budget_;
+
+    std::size_t max_frame_size_;
+
+    std::unique_ptr<std::byte[]> buffer_;
+
+    //! The offset where the next slot is written.
+    std::size_t head_{ 0 };
+
+    //! The offset of the oldest slot that has not been reclaimed.
+    std::size_t tail_{ 0 };
+
+    //! The size of slots that have not been reclaimed.
+    std::size_t used_{ 0 };
+};
+
+}  // namespace net
@@ -0,0 +1,238 @@
+/**
+ * @file reliable.h
+ * @brief The reliability layer over datagrams.
+ *
+ * @details
+ * Messages carry sequence numbers and are acknowledged selectively:
+ * each datagram acknowledges every sequence number below a cumulative one,
+ * plus a bitmap of the following 32 ones.
+ * Unacknowledged messages are resent until they are acknowledged.
+ * Sequence numbers wrap around and are compared with serial number arithmetic,
+ * so two of them are ordered as long as they are less than 2^31 apart.
+ *
+ * The layer does no I/O by itself. Callers feed received datagrams and the current time,
+ * and send the datagrams it produces, so it can run over any socket or an in-memory link.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <random>
+#include <set>
+#include <span>
+#include <vector>
+
+
+namespace net {
+
+//! Delivery guarantees of reliable messages.
+enum class Delivery : std::uint8_t {
+    //! Delivered once as soon as it arrives, without waiting for earlier messages.
+    Unordered = 1,
+
+    //! Delivered once after all earlier messages, whether ordered or not.
+    Ordered = 2
+};
+
+//! Options of reliable channels.
+struct ReliableOptions {
+    //! The time to wait for an acknowledgement before resending a message.
+    std::chrono::steady_clock::duration resend_timeout{
+        std::chrono::milliseconds{ 100 }
+    };
+
+    //! The maximum number of transmissions of a message before the peer is considered lost.
+    std::size_t max_transmissions{ 30 };
+
+    //! The probability of dropping an outgoing datagram, used to simulate loss.
+    double loss_rate{ 0 };
+
+    //! The seed of loss simulation.
+    std::uint32_t loss_seed{ 1 };
+
+    //! The first sequence number, which must be the same on both ends.
+    std::uint32_t initial_seq{ 0 };
+};
+
+//! Statistics of reliable channels.
+struct ReliableStats {
+    //! The number of transmitted datagrams, including resends and acknowledgements.
+    std::size_t sent;
+
+    //! The number of resent messages.
+    std::size_t resent;
+
+    //! The number of datagrams dropped by loss simulation.
+    std::size_t dropped;
+
+    //! The number of delivered messages.
+    std::size_t delivered;
+
+    //! The number of received duplicate messages.
+    std::size_t duplicates;
+};
+
+/**
+ * @brief One end of a reliable channel.
+ *
+ * @details It is not thread-safe.
+ */
+class ReliableChannel final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! The handler sending a datagram.
+    using Transmit = std::function<void(std::span<const std::byte>)>;
+
+    //! The handler receiving a message.
+    using Deliver = std::function<void(std::span<const std::byte>)>;
+
+    //! The maximum size of a message, keeping datagrams below common MTUs.
+    static constexpr std::size_t max_msg_size{ 1200 };
+
+    //! Check whether a sequence number is before another one, allowing for wraparound.
+    static constexpr bool SeqBefore(const std::uint32_t lhs,
+                                    const std::uint32_t rhs) noexcept {
+        return static_cast<std::int32_t>(lhs - rhs) < 0;
+    }
+
+    /**
+     * @brief Create a channel.
+     *
+     * @param transmit A handler sending datagrams to the peer.
+     * @param deliver A handler receiving messages from the peer.
+     * @param options Options.
+     *
+     * @exception std::invalid_argument The options are invalid.
+     */
+    ReliableChannel(Transmit transmit, Deliver deliver,
+                    const ReliableOptions& options = {});
+
+    /**
+     * @brief Send a message.
+     *
+     * @param msg A message.
+     * @param delivery The delivery guarantee.
+     * @param now The current time.
+     *
+     * @exception std::invalid_argument The message is too large.
+     */
+    void Send(std::span<const std::byte> msg, Delivery delivery,
+              Clock::time_point now);
+
+    /**
+     * @brief Handle a datagram from the peer.
+     *
+     * @details Messages in the datagram are passed to the deliver handler.
+     *
+     * @param datagram A datagram.
+     * @return @p false if the datagram is malformed and has been ignored.
+     */
+    bool Receive(std::span<const std::byte> datagram);
+
+    /**
+     * @brief Resend expired messages and send a pending acknowledgement.
+     *
+     * @param now The current time.
+     *
+     * @exception std::runtime_error The peer has not acknowledged a message in time.
+     */
+    void Poll(Clock::time_point now);
+
+    /**
+     * @brief Get the time when @p Poll should be called.
+     *
+     * @return A time point, which may be in the past, or an empty value if nothing is waiting.
+     */
+    std::optional<Clock::time_point> NextDeadline() const noexcept;
+
+    //! Get the number of unacknowledged messages.
+    std::size_t Unacknowledged() const noexcept;
+
+    //! Get statistics.
+    const ReliableStats& Stats() const noexcept;
+
+private:
+    //! The maximum distance of an accepted sequence number from the cumulative acknowledgement.
+    static constexpr std::uint32_t max_seq_window{ 1024 };
+
+    //! The order of sequence numbers in containers.
+    struct SeqLess {
+        constexpr bool operator()(const std::uint32_t lhs,
+                                  const std::uint32_t rhs) const noexcept {
+            return SeqBefore(lhs, rhs);
+        }
+    };
+
+    //! A message waiting for its acknowledgement.
+    struct Pending {
+        Delivery delivery;
+        std::vector<std::byte> msg;
+        Clock::time_point deadline;
+        std::size_t transmissions;
+    };
+
+    //! Transmit a message with the latest acknowledgement.
+    void TransmitMsg(std::uint32_t seq, Pending& pending,
+                     Clock::time_point now);
+
+    //! Send a datagram, which may be dropped by loss simulation.
+    void Output(std::span<const std::byte> datagram);
+
+    //! Remove acknowledged messages.
+    void Acknowledge(std::uint32_t ack, std::uint32_t ack_bits);
+
+    //! Get the bitmap of received sequence numbers after the cumulative acknowledgement.
+    std::uint32_t AckBits() const noexcept;
+
+    //! Record a received sequence number.
+    bool Record(std::uint32_t seq);
+
+    //! Deliver held ordered messages whose earlier messages have all been received.
+    void DeliverHeld();
+
+    Transmit transmit_;
+    Deliver deliver_;
+    ReliableOptions options_;
+
+    //! The next sequence number to send.
+    std::uint32_t next_seq_;
+
+    std::map<std::uint32_t, Pending, SeqLess> unacked_{};
+
+    //! The next sequence number expected from the peer. All earlier ones have been received.
+    std::uint32_t next_expected_;
+
+    //! Sequence numbers received after a gap.
+    std::set<std::uint32_t, SeqLess> early_{};
+
+    //! Ordered messages received after a gap, by sequence numbers.
+    std::map<std::uint32_t, std::vector<std::byte>, SeqLess> held_{};
+
+    //! Whether an acknowledgement has to be sent.
+    bool ack_pending_{ false };
+
+    std::minstd_rand loss_rng_;
+    std::uniform_real_distribution<double> loss_dist_{ 0, 1 };
+
+    //! The buffer building datagrams.
+    std::vector<std::byte> datagram_{};
+
+    ReliableStats stats_{};
+};
+
+}  // namespace net
@@ -0,0 +1,148 @@
+/**
+ * @file resolver.h
+ * @brief The cached asynchronous name resolver.
+ *
+ * @details
+ * System resolution blocks, so each lookup runs on a background thread
+ * and coroutines waiting for it are resumed on their own event loops.
+ * Results are cached for a period of time, and a host can be resolved in advance,
+ * so connecting to it later adds no resolution latency.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "async.h"
+#include "ip_addr.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+
+namespace net {
+
+/**
+ * @brief The cached asynchronous name resolver.
+ *
+ * @details
+ * It is thread-safe.
+ * Lookup threads are joined once they are done or the resolver is destroyed,
+ * so none of them outlives the module that started it.
+ * Waiting for a thread under the Windows loader lock can deadlock,
+ * so a module should call @p Join on its own thread rather than from @p DllMain.
+ * Failures are not cached.
+ */
+class Resolver final {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! The default time to keep a result.
+    static constexpr std::chrono::seconds default_ttl{ 300 };
+
+    /**
+     * @brief Create a resolver.
+     *
+     * @param ttl The time to keep a result.
+     */
+    explicit Resolver(Clock::duration ttl = default_ttl) noexcept;
+
+    //! Wait for pending lookups.
+    ~Resolver() noexcept;
+
+    Resolver(const Resolver&) = delete;
+
+    Resolver& operator=(const Resolver&) = delete;
+
+    /**
+     * @brief Start to resolve a host in the background unless a result is cached.
+     *
+     * @param host A host name or a numeric IP address.
+     * @param port A port number.
+     *
+     * @exception std::system_error The lookup thread cannot be started.
+     */
+    void Prefetch(std::string_view host, std::uint16_t port);
+
+    /**
+     * @brief Resolve a host, waiting for the lookup if no result is cached.
+     *
+     * @param host A host name or a numeric IP address.
+     * @param port A port number.
+     * @return Non-empty addresses in the order of @p net::Resolve.
+     *
+     * @exception std::runtime_error The resolution failed.
+     * @exception std::system_error The lookup thread cannot be started.
+     */
+    std::vector<SockAddr> Resolve(std::string_view host, std::uint16_t port);
+
+    /**
+     * @brief Resolve a host in a coroutine without blocking the event loop.
+     *
+     * @param host A host name or a numeric IP address.
+     * @param port A port number.
+     * @param stop_token A token cancelling the wait. The lookup itself still completes and is cached.
+     * @return Non-empty addresses in the order of @p net::Resolve.
+     *
+     * @exception std::runtime_error The resolution failed.
+     * @exception std::system_error
+     * The lookup thread cannot be started or the wait has been cancelled.
+     */
+    Task<std::vector<SockAddr>> AsyncResolve(std::string host,
+                                             std::uint16_t port,
+                                             std::stop_token stop_token = {});
+
+    //! Remove all cached results.
+    void Clear() noexcept;
+
+    /**
+     * @brief Wait for pending lookups.
+     *
+     * @details
+     * It must be called before the code of lookup threads is unloaded,
+     * but not under the loader lock, since an ending thread needs the lock.
+     */
+    void Join() noexcept;
+
+    //! A lookup shared by the resolver, its thread and waiting coroutines.
+    struct Lookup;
+
+private:
+    /**
+     * @brief Get a pending or cached lookup, or start a new one.
+     *
+     * @exception std::system_error The lookup thread cannot be started.
+     */
+    std::shared_ptr<Lookup> Find(std::string_view host, std::uint16_t port);
+
+    //! Join threads of done lookups. The caller must hold the lock.
+    void JoinDone() noexcept;
+
+    Clock::duration ttl_;
+
+    std::mutex mtx_{};
+
+    std::map<std::pair<std::string, std::uint16_t>, std::shared_ptr<Lookup>>
+        cache_{};
+
+    //! Lookup threads with their lookups.
+    std::vector<std::pair<std::shared_ptr<Lookup>, std::thread>> threads_{};
+};
+
+}  // namespace net
@@ -14,15 +14,14 @@
 
 #pragma once
 
-#define _WINSOCKAPI_
+#include "option.h"
 
 #include "network/ip_addr.h"
+#include "network/platform.h"
 
-#include "system/windows_error.h"
-
-#include <winsock2.h>
-
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <string_view>
 
@@ -39,6 +38,24 @@ namespace net {
  */
 void CheckSizeLimit(std::size_t size, std::string_view msg);
 
+//! The maximum number of buffers sent by a single vectored send.
+inline constexpr std::size_t max_send_buffers{ 16 };
+
+/**
+ * @brief Send data in several buffers with a single system call.
+ *
+ * @details It uses @p sendmsg on BSD sockets and @p WSASend on Windows.
+ *
+ * @param id A socket handle.
+ * @param buffers Buffers. At most @p max_send_buffers buffers are sent.
+ * @return The total size of sent data.
+ *
+ * @exception std::overflow_error The data is too large.
+ * @exception std::system_error The operation failed.
+ */
+std::size_t SendBuffers(SocketId id,
+                        std::span<const std::span<const std::byte>> buffers);
+
 /**
  * @interface Socket
  * @brief The socket interface.
@@ -56,7 +73,7 @@ public:
      *
      * @param id A socket handle.
      */
-    Socket(SOCKET id) noexcept;
+    Socket(SocketId id) noexcept;
 
     Socket(Socket&& that) noexcept;
 
@@ -70,7 +87,7 @@ public:
     bool Valid() const noexcept;
 
     //! Get the low-level socket handle.
-    SOCKET ID() const noexcept;
+    SocketId ID() const noexcept;
 
     /**
      * @brief Get the IP address.
@@ -89,13 +106,56 @@ public:
      */
     void Bind() const;
 
+    /**
+     * @brief Get the local IP address of the socket.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    ADDR LocalAddr() const;
+
+    /**
+     * @brief Enable or disable the non-blocking mode.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    void SetNonBlocking(bool enable) const;
+
+    /**
+     * @brief Set an option.
+     *
+     * @tparam OPTION An option in @p net::opt.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    template <SocketOption OPTION>
+    void SetOption(typename OPTION::Type val) const;
+
+    /**
+     * @brief Get an option.
+     *
+     * @tparam OPTION An option in @p net::opt.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    template <SocketOption OPTION>
+    typename OPTION::Type Option() const;
+
+    /**
+     * @brief Apply a latency profile.
+     *
+     * @details It should be called after the connection is set up.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    void Apply(const LatencyProfile& profile) const;
+
     //! Close the socket.
     void Close() noexcept;
 
 protected:
     virtual ~Socket() noexcept;
 
-    SOCKET id_{ INVALID_SOCKET };
+    SocketId id_{ invalid_socket };
 
 private:
     std::unique_ptr<ADDR> addr_{};
@@ -106,19 +166,19 @@ template <ValidIpAddr ADDR>
 Socket<ADDR>::Socket() noexcept = default;
 
 template <ValidIpAddr ADDR>
-Socket<ADDR>::Socket(const SOCKET id) noexcept : id_{ id } {}
+Socket<ADDR>::Socket(const SocketId id) noexcept : id_{ id } {}
 
 template <ValidIpAddr ADDR>
 Socket<ADDR>::Socket(Socket&& that) noexcept :
     id_{ that.id_ }, addr_{ std::move(that.addr_) } {
-    that.id_ = INVALID_SOCKET;
+    that.id_ = invalid_socket;
 }
 
 template <ValidIpAddr ADDR>
 Socket<ADDR>& Socket<ADDR>::operator=(Socket&& that) & noexcept {
     id_ = that.id_;
     addr_ = std::move(that.addr_);
-    that.id_ = INVALID_SOCKET;
+    that.id_ = invalid_socket;
     return *this;
 }
 
@@ -129,11 +189,11 @@ Socket<ADDR>::~Socket() noexcept {
 
 template <ValidIpAddr ADDR>
 bool Socket<ADDR>::Valid() const noexcept {
-    return id_ != INVALID_SOCKET;
+    return id_ != invalid_socket;
 }
 
 template <ValidIpAddr ADDR>
-SOCKET Socket<ADDR>::ID() const noexcept {
+SocketId Socket<ADDR>::ID() const noexcept {
     return id_;
 }
 
@@ -154,17 +214,52 @@ void Socket<ADDR>::SetAddr(const ADDR& addr) noexcept {
 
 template <ValidIpAddr ADDR>
 void Socket<ADDR>::Bind() const {
-    if (bind(id_, Addr().Raw(), Addr().Size()) == SOCKET_ERROR) {
-        sys::ThrowWsaLastError();
+    if (bind(id_, Addr().Raw(), static_cast<SockLen>(Addr().Size()))
+        == socket_error) {
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+ADDR Socket<ADDR>::LocalAddr() const {
+    typename ADDR::RawType addr{};
+    SockLen size{ sizeof(addr) };
+    if (getsockname(id_, reinterpret_cast<sockaddr*>(&addr), &size)
+        == socket_error) {
+        ThrowLastSocketError();
     }
+
+    return ADDR{ addr };
+}
+
+template <ValidIpAddr ADDR>
+void Socket<ADDR>::SetNonBlocking(const bool enable) const {
+    net::SetNonBlocking(id_, enable);
+}
+
+template <ValidIpAddr ADDR>
+template <SocketOption OPTION>
+void Socket<ADDR>::SetOption(const typename OPTION::Type val) const {
+    SetSocketOption<OPTION>(id_, val);
+}
+
+template <ValidIpAddr ADDR>
+template <SocketOption OPTION>
+typename OPTION::Type Socket<ADDR>::Option() const {
+    return SocketOptionOf<OPTION>(id_);
+}
+
+template <ValidIpAddr ADDR>
+void Socket<ADDR>::Apply(const LatencyProfile& profile) const {
+    ApplyLatencyProfile(id_, profile);
 }
 
 
 template <ValidIpAddr ADDR>
 void Socket<ADDR>::Close() noexcept {
     if (Valid()) {
-        closesocket(id_);
-        id_ = INVALID_SOCKET;
+        CloseSocket(id_);
+        id_ = invalid_socket;
     }
 }
 
@@ -0,0 +1,274 @@
+/**
+ * @file option.h
+ * @brief Socket options and latency profiles.
+ *
+ * @details
+ * Each option is a type describing its level, name and value type,
+ * so options can be set and read through @p Socket without raw @p setsockopt calls.
+ * A latency profile applies a group of options at once after a connection is set up.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "network/platform.h"
+
+#include <chrono>
+#include <concepts>
+#include <optional>
+#include <string_view>
+
+
+namespace net {
+
+//! A socket option whose value is stored as an @p int.
+template <typename T>
+concept SocketOption = requires {
+    { T::level } -> std::convertible_to<int>;
+    { T::name } -> std::convertible_to<int>;
+} && std::convertible_to<typename T::Type, int>;
+
+namespace opt {
+
+//! Disable Nagle's algorithm, so small packets are sent immediately.
+struct NoDelay {
+    using Type = bool;
+    static constexpr int level{ IPPROTO_TCP };
+    static constexpr int name{ TCP_NODELAY };
+};
+
+//! The size of the send buffer in bytes.
+struct SendBuffer {
+    using Type = int;
+    static constexpr int level{ SOL_SOCKET };
+    static constexpr int name{ SO_SNDBUF };
+};
+
+//! The size of the receive buffer in bytes.
+struct RecvBuffer {
+    using Type = int;
+    static constexpr int level{ SOL_SOCKET };
+    static constexpr int name{ SO_RCVBUF };
+};
+
+//! Allow reusing a local address in the @p TIME_WAIT state.
+struct ReuseAddr {
+    using Type = bool;
+    static constexpr int level{ SOL_SOCKET };
+    static constexpr int name{ SO_REUSEADDR };
+};
+
+#ifdef SO_REUSEPORT
+/**
+ * @brief Allow several sockets to bind the same address.
+ *
+ * @details The kernel spreads incoming connections across listening sockets sharing the address.
+ */
+struct ReusePort {
+    using Type = bool;
+    static constexpr int level{ SOL_SOCKET };
+    static constexpr int name{ SO_REUSEPORT };
+};
+#endif  // SO_REUSEPORT
+
+//! Only use IPv6 on an IPv6 socket, instead of also accepting IPv4-mapped addresses.
+struct V6Only {
+    using Type = bool;
+    static constexpr int level{ IPPROTO_IPV6 };
+    static constexpr int name{ IPV6_V6ONLY };
+};
+
+//! Send keep-alive probes on an idle connection.
+struct KeepAlive {
+    using Type = bool;
+    static constexpr int level{ SOL_SOCKET };
+    static constexpr int name{ SO_KEEPALIVE };
+};
+
+//! The idle time in seconds before the first keep-alive probe.
+struct KeepIdle {
+    using Type = int;
+    static constexpr int level{ IPPROTO_TCP };
+    static constexpr int name{ TCP_KEEPIDLE };
+};
+
+//! The interval in seconds between keep-alive probes.
+struct KeepInterval {
+    using Type = int;
+    static constexpr int level{ IPPROTO_TCP };
+    static constexpr int name{ TCP_KEEPINTVL };
+};
+
+//! The number of unanswered keep-alive probes before the connection is dropped.
+struct KeepCount {
+    using Type = int;
+    static constexpr int level{ IPPROTO_TCP };
+    static constexpr int name{ TCP_KEEPCNT };
+};
+
+#ifdef __linux__
+/**
+ * @brief Send acknowledgements immediately instead of delaying them.
+ *
+ * @details It is not permanent and the kernel may turn it off later.
+ */
+struct QuickAck {
+    using Type = bool;
+    static constexpr int level{ IPPROTO_TCP };
+    static constexpr int name{ TCP_QUICKACK };
+};
+
+//! The time in microseconds to busy poll the device queue when receiving.
+struct BusyPoll {
+    using Type = int;
+    static constexpr int level{ SOL_SOCKET };
+    static constexpr int name{ SO_BUSY_POLL };
+};
+
+//! The priority of sent packets, used by queueing disciplines.
+struct Priority {
+    using Type = int;
+    static constexpr int level{ SOL_SOCKET };
+    static constexpr int name{ SO_PRIORITY };
+};
+#endif  // __linux__
+
+}  // namespace opt
+
+/**
+ * @brief Set an option of a socket.
+ *
+ * @tparam OPTION An option.
+ * @param id A socket handle.
+ * @param val A value.
+ *
+ * @exception std::system_error The operation failed.
+ */
+template <SocketOption OPTION>
+void SetSocketOption(const SocketId id, const typename OPTION::Type val) {
+    const int raw{ static_cast<int>(val) };
+    if (setsockopt(id, OPTION::level, OPTION::name,
+                   reinterpret_cast<const char*>(&raw), sizeof(raw))
+        == socket_error) {
+        ThrowLastSocketError();
+    }
+}
+
+/**
+ * @brief Get an option of a socket.
+ *
+ * @tparam OPTION An option.
+ * @param id A socket handle.
+ * @return The value.
+ *
+ * @exception std::system_error The operation failed.
+ */
+template <SocketOption OPTION>
+typename OPTION::Type SocketOptionOf(const SocketId id) {
+    int raw{ 0 };
+    auto size{ static_cast<SockLen>(sizeof(raw)) };
+    if (getsockopt(id, OPTION::level, OPTION::name,
+                   reinterpret_cast<char*>(&raw), &size)
+        == socket_error) {
+        ThrowLastSocketError();
+    }
+
+    if constexpr (std::same_as<typename OPTION::Type, bool>) {
+        return raw != 0;
+    } else {
+        return static_cast<typename OPTION::Type>(raw);
+    }
+}
+
+
+//! Keep-alive timings.
+struct KeepAliveTimings {
+    //! The idle time before the first probe.
+    std::chrono::seconds idle;
+
+    //! The interval between probes.
+    std::chrono::seconds interval;
+
+    //! The number of unanswered probes before the connection is dropped.
+    int count;
+};
+
+/**
+ * @brief A group of options tuning the latency of a connection.
+ *
+ * @details
+ * Empty options keep system defaults.
+ * Linux-only options are ignored on other platforms.
+ */
+struct LatencyProfile {
+    //! The profile name in configuration files.
+    std::string_view name;
+
+    //! Whether to disable Nagle's algorithm.
+    bool no_delay{ false };
+
+    //! Whether to send acknowledgements immediately. It only works on Linux.
+    bool quick_ack{ false };
+
+    //! The size of the send buffer in bytes.
+    std::optional<int> send_buffer{};
+
+    //! The size of the receive buffer in bytes.
+    std::optional<int> recv_buffer{};
+
+    //! Keep-alive timings.
+    std::optional<KeepAliveTimings> keep_alive{};
+
+    //! The busy polling time. It only works on Linux.
+    std::optional<std::chrono::microseconds> busy_poll{};
+
+    //! The priority of sent packets. It only works on Linux.
+    std::optional<int> priority{};
+
+    //! System defaults.
+    static const LatencyProfile standard;
+
+    //! Immediate sends and acknowledgements, for small real-time packets.
+    static const LatencyProfile low_latency;
+
+    /**
+     * @brief @p low_latency with busy polling.
+     *
+     * @details
+     * It only works on Linux and needs the @p CAP_NET_ADMIN capability
+     * unless @p net.core.busy_poll is large enough.
+     */
+    static const LatencyProfile busy_poll_latency;
+
+    //! Large buffers with Nagle's algorithm, for bulk transfers.
+    static const LatencyProfile throughput;
+
+    /**
+     * @brief Get a predefined profile by its name.
+     *
+     * @param name A case-sensitive profile name.
+     *
+     * @exception std::invalid_argument The profile does not exist.
+     */
+    static const LatencyProfile& FromName(std::string_view name);
+};
+
+/**
+ * @brief Apply a latency profile to a connected socket.
+ *
+ * @param id A socket handle.
+ * @param profile A profile.
+ *
+ * @exception std::system_error The operation failed.
+ */
+void ApplyLatencyProfile(SocketId id, const LatencyProfile& profile);
+
+}  // namespace net
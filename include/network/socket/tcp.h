@@ -14,18 +14,44 @@
 
 #pragma once
 
-#define _WINSOCKAPI_
-
 #include "basic.h"
 
-#include "system/windows_error.h"
+#include "network/async.h"
+#include "network/platform.h"
 
+#include <concepts>
 #include <cstddef>
 #include <span>
+#include <stop_token>
+#include <system_error>
 
 
 namespace net {
 
+//! A connected socket that can send and receive a stream of bytes.
+template <typename T>
+concept StreamSocket = requires(T& socket, std::span<const std::byte> data,
+                                std::span<std::byte> buffer) {
+    { socket.Send(data) } -> std::same_as<std::size_t>;
+    { socket.Recv(buffer) } -> std::same_as<std::size_t>;
+};
+
+//! A stream socket that can send data in several buffers with a single call.
+template <typename T>
+concept VectoredStreamSocket =
+    StreamSocket<T>
+    && requires(T& socket,
+                std::span<const std::span<const std::byte>> buffers) {
+           { socket.Send(buffers) } -> std::same_as<std::size_t>;
+       };
+
+//! A connected socket that can receive a stream of bytes in coroutines.
+template <typename T>
+concept AsyncStreamSocket = requires(T& socket, std::span<std::byte> buffer,
+                                     std::stop_token stop_token) {
+    { socket.AsyncRecv(buffer, stop_token) } -> std::same_as<Task<std::size_t>>;
+};
+
 /**
  * @brief The TCP socket.
  *
@@ -43,6 +69,17 @@ public:
      */
     TcpSocket();
 
+    /**
+     * @brief Construct a TCP socket of the version of an address.
+     *
+     * @details It is needed when the version of @p ADDR is chosen at runtime.
+     *
+     * @param addr An IP address to connect to or bind.
+     *
+     * @exception std::system_error The initialization failed.
+     */
+    explicit TcpSocket(const ADDR& addr);
+
     /**
      * @brief Connect to a server.
      *
@@ -59,6 +96,19 @@ public:
      */
     std::size_t Send(std::span<const std::byte> data) const;
 
+    /**
+     * @brief Send data in several buffers with a single system call.
+     *
+     * @details It may send only a part of data.
+     *
+     * @param buffers Buffers. At most @p max_send_buffers buffers are sent.
+     * @return The total size of sent data.
+     *
+     * @exception std::overflow_error The data is too large.
+     * @exception std::system_error The operation failed.
+     */
+    std::size_t Send(std::span<const std::span<const std::byte>> buffers) const;
+
     /**
      * @brief Receive data.
      *
@@ -67,21 +117,66 @@ public:
      * @exception std::system_error The operation failed.
      */
     std::size_t Recv(std::span<std::byte> buffer) const;
+
+    /**
+     * @brief Connect to a server in a coroutine.
+     *
+     * @details The socket is in the non-blocking mode only while connecting.
+     *
+     * @param addr An IP address.
+     * @param stop_token A token cancelling the operation.
+     *
+     * @exception std::system_error The operation failed or has been cancelled.
+     */
+    Task<> AsyncConnect(ADDR addr, std::stop_token stop_token = {}) const;
+
+    /**
+     * @brief Send data in a coroutine.
+     *
+     * @details It waits until the socket is writable and sends data once.
+     *
+     * @exception std::system_error The operation failed or has been cancelled.
+     */
+    Task<std::size_t> AsyncSend(std::span<const std::byte> data,
+                                std::stop_token stop_token = {}) const;
+
+    /**
+     * @brief Receive data in a coroutine.
+     *
+     * @details It waits until the socket is readable and receives data once.
+     *
+     * @param buffer A buffer storing data. The function tries to fill this buffer.
+     * @param stop_token A token cancelling the operation.
+     * @return The size of received data, or @p 0 if the connection has been closed.
+     *
+     * @exception std::system_error The operation failed or has been cancelled.
+     */
+    Task<std::size_t> AsyncRecv(std::span<std::byte> buffer,
+                                std::stop_token stop_token = {}) const;
 };
 
 
 template <ValidIpAddr ADDR>
 TcpSocket<ADDR>::TcpSocket() :
     Socket<ADDR>{ socket(ADDR::version, SOCK_STREAM, 0) } {
-    if (this->id_ == INVALID_SOCKET) {
-        sys::ThrowWsaLastError();
+    if (this->id_ == invalid_socket) {
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+TcpSocket<ADDR>::TcpSocket(const ADDR& addr) :
+    Socket<ADDR>{ socket(addr.Version(), SOCK_STREAM, 0) } {
+    if (this->id_ == invalid_socket) {
+        ThrowLastSocketError();
     }
 }
 
 template <ValidIpAddr ADDR>
 void TcpSocket<ADDR>::Connect(const ADDR& addr) const {
-    if (connect(this->id_, addr.Raw(), addr.Size()) == SOCKET_ERROR) {
-        sys::ThrowWsaLastError();
+    if (connect(this->id_, addr.Raw(), static_cast<SockLen>(addr.Size()))
+        == socket_error) {
+        ThrowLastSocketError();
     }
 }
 
@@ -92,14 +187,20 @@ std::size_t TcpSocket<ADDR>::Send(const std::span<const std::byte> data) const {
 
     if (const auto sent{ send(this->id_,
                               reinterpret_cast<const char*>(data.data()),
-                              data.size_bytes(), 0) };
-        sent != SOCKET_ERROR) {
+                              data.size_bytes(), send_flags) };
+        sent != socket_error) {
         return static_cast<std::size_t>(sent);
     } else {
-        sys::ThrowWsaLastError();
+        ThrowLastSocketError();
     }
 }
 
+template <ValidIpAddr ADDR>
+std::size_t TcpSocket<ADDR>::Send(
+    const std::span<const std::span<const std::byte>> buffers) const {
+    return SendBuffers(this->id_, buffers);
+}
+
 template <ValidIpAddr ADDR>
 std::size_t TcpSocket<ADDR>::Recv(const std::span<std::byte> buffer) const {
     CheckSizeLimit(buffer.size_bytes(),
@@ -108,11 +209,51 @@ std::size_t TcpSocket<ADDR>::Recv(const std::span<std::byte> buffer) const {
     if (const auto received{ recv(this->id_,
                                   reinterpret_cast<char*>(buffer.data()),
                                   buffer.size_bytes(), 0) };
-        received != SOCKET_ERROR) {
-        return received;
+        received != socket_error) {
+        return static_cast<std::size_t>(received);
     } else {
-        sys::ThrowWsaLastError();
+        ThrowLastSocketError();
+    }
+}
+
+
+template <ValidIpAddr ADDR>
+Task<> TcpSocket<ADDR>::AsyncConnect(const ADDR addr,
+                                     const std::stop_token stop_token) const {
+    this->SetNonBlocking(true);
+    try {
+        if (connect(this->id_, addr.Raw(), static_cast<SockLen>(addr.Size()))
+            == socket_error) {
+            if (!LastSocketErrorWouldBlock()) {
+                ThrowLastSocketError();
+            }
+
+            co_await Executor::Current().Writable(this->id_, stop_token);
+            if (const auto err{ TakeSocketError(this->id_) }; err != 0) {
+                throw std::system_error{ err, std::system_category() };
+            }
+        }
+    } catch (...) {
+        this->SetNonBlocking(false);
+        throw;
     }
+
+    this->SetNonBlocking(false);
+}
+
+template <ValidIpAddr ADDR>
+Task<std::size_t> TcpSocket<ADDR>::AsyncSend(
+    const std::span<const std::byte> data,
+    const std::stop_token stop_token) const {
+    co_await Executor::Current().Writable(this->id_, stop_token);
+    co_return Send(data);
+}
+
+template <ValidIpAddr ADDR>
+Task<std::size_t> TcpSocket<ADDR>::AsyncRecv(
+    const std::span<std::byte> buffer, const std::stop_token stop_token) const {
+    co_await Executor::Current().Readable(this->id_, stop_token);
+    co_return Recv(buffer);
 }
 
 }  // namespace net
\ No newline at end of file
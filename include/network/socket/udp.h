@@ -0,0 +1,216 @@
+/**
+ * @file udp.h
+ * @brief The UDP socket.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "basic.h"
+
+#include "network/async.h"
+#include "network/platform.h"
+
+#include <cstddef>
+#include <span>
+#include <stop_token>
+#include <utility>
+
+
+namespace net {
+
+/**
+ * @brief The UDP socket.
+ *
+ * @details
+ * Each call sends or receives a whole datagram.
+ * A datagram larger than the receiving buffer is truncated.
+ *
+ * @tparam ADDR An IP address.
+ */
+template <ValidIpAddr ADDR>
+class UdpSocket : public Socket<ADDR> {
+public:
+    using Socket<ADDR>::Socket;
+
+    /**
+     * @brief Construct a UDP socket.
+     *
+     * @exception std::system_error The initialization failed.
+     */
+    UdpSocket();
+
+    /**
+     * @brief Construct a UDP socket of the version of an address.
+     *
+     * @details It is needed when the version of @p ADDR is chosen at runtime.
+     *
+     * @param addr An IP address to connect to or bind.
+     *
+     * @exception std::system_error The initialization failed.
+     */
+    explicit UdpSocket(const ADDR& addr);
+
+    /**
+     * @brief Set the default peer, and only receive datagrams from it.
+     *
+     * @param addr An IP address.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    void Connect(const ADDR& addr) const;
+
+    /**
+     * @brief Send a datagram to the default peer.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    std::size_t Send(std::span<const std::byte> data) const;
+
+    /**
+     * @brief Send a datagram to a peer.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    std::size_t SendTo(std::span<const std::byte> data, const ADDR& addr) const;
+
+    /**
+     * @brief Receive a datagram.
+     *
+     * @param buffer A buffer storing the datagram.
+     * @return The size of the datagram.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    std::size_t Recv(std::span<std::byte> buffer) const;
+
+    /**
+     * @brief Receive a datagram and get its sender.
+     *
+     * @param buffer A buffer storing the datagram.
+     * @return The size of the datagram and the sender.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    std::pair<std::size_t, ADDR> RecvFrom(std::span<std::byte> buffer) const;
+
+    /**
+     * @brief Receive a datagram in a coroutine.
+     *
+     * @param buffer A buffer storing the datagram.
+     * @param stop_token A token cancelling the operation.
+     * @return The size of the datagram.
+     *
+     * @exception std::system_error The operation failed or has been cancelled.
+     */
+    Task<std::size_t> AsyncRecv(std::span<std::byte> buffer,
+                                std::stop_token stop_token = {}) const;
+};
+
+
+template <ValidIpAddr ADDR>
+UdpSocket<ADDR>::UdpSocket() :
+    Socket<ADDR>{ socket(ADDR::version, SOCK_DGRAM, 0) } {
+    if (this->id_ == invalid_socket) {
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+UdpSocket<ADDR>::UdpSocket(const ADDR& addr) :
+    Socket<ADDR>{ socket(addr.Version(), SOCK_DGRAM, 0) } {
+    if (this->id_ == invalid_socket) {
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+void UdpSocket<ADDR>::Connect(const ADDR& addr) const {
+    if (connect(this->id_, addr.Raw(), static_cast<SockLen>(addr.Size()))
+        == socket_error) {
+        ThrowLastSocketError();
+    }
+}
+
+
+template <ValidIpAddr ADDR>
+std::size_t UdpSocket<ADDR>::Send(const std::span<const std::byte> data) const {
+    CheckSizeLimit(data.size_bytes(), "The size of data is too large to send.");
+
+    if (const auto sent{ send(this->id_,
+                              reinterpret_cast<const char*>(data.data()),
+                              data.size_bytes(), send_flags) };
+        sent != socket_error) {
+        return static_cast<std::size_t>(sent);
+    } else {
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+std::size_t UdpSocket<ADDR>::SendTo(const std::span<const std::byte> data,
+                                    const ADDR& addr) const {
+    CheckSizeLimit(data.size_bytes(), "The size of data is too large to send.");
+
+    if (const auto sent{ sendto(this->id_,
+                                reinterpret_cast<const char*>(data.data()),
+                                data.size_bytes(), send_flags, addr.Raw(),
+                                static_cast<SockLen>(addr.Size())) };
+        sent != socket_error) {
+        return static_cast<std::size_t>(sent);
+    } else {
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+std::size_t UdpSocket<ADDR>::Recv(const std::span<std::byte> buffer) const {
+    CheckSizeLimit(buffer.size_bytes(),
+                   "The size of buffer is too large to receive data.");
+
+    if (const auto received{ recv(this->id_,
+                                  reinterpret_cast<char*>(buffer.data()),
+                                  buffer.size_bytes(), 0) };
+        received != socket_error) {
+        return static_cast<std::size_t>(received);
+    } else {
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+std::pair<std::size_t, ADDR> UdpSocket<ADDR>::RecvFrom(
+    const std::span<std::byte> buffer) const {
+    CheckSizeLimit(buffer.size_bytes(),
+                   "The size of buffer is too large to receive data.");
+
+    typename ADDR::RawType addr{};
+    SockLen size{ sizeof(addr) };
+    if (const auto received{ recvfrom(this->id_,
+                                      reinterpret_cast<char*>(buffer.data()),
+                                      buffer.size_bytes(), 0,
+                                      reinterpret_cast<sockaddr*>(&addr),
+                                      &size) };
+        received != socket_error) {
+        return { static_cast<std::size_t>(received), ADDR{ addr } };
+    } else {
+        ThrowLastSocketError();
+    }
+}
+
+template <ValidIpAddr ADDR>
+Task<std::size_t> UdpSocket<ADDR>::AsyncRecv(
+    const std::span<std::byte> buffer, const std::stop_token stop_token) const {
+    co_await Executor::Current().Readable(this->id_, stop_token);
+    co_return Recv(buffer);
+}
+
+}  // namespace net
@@ -0,0 +1,339 @@
+/**
+ * @file uring.h
+ * @brief The io_uring transport of TCP sockets.
+ *
+ * @details
+ * It is only available on Linux.
+ * A multishot receive is kept armed into a ring of kernel-registered buffers,
+ * and data sent between two flushes is submitted by a single @p io_uring_enter.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#ifndef __linux__
+    #error "The io_uring transport is only available on Linux."
+#endif  // __linux__
+
+#include "tcp.h"
+
+#include "network/ip_addr.h"
+#include "network/platform.h"
+
+#include <linux/io_uring.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+
+namespace net {
+
+//! Options of the io_uring transport.
+struct UringOptions {
+    //! The number of submission queue entries.
+    std::uint32_t queue_depth{ 64 };
+
+    //! The number of registered receive buffers. It must be a power of 2.
+    std::uint16_t buffer_count{ 64 };
+
+    //! The size of each receive buffer.
+    std::uint32_t buffer_size{ 4096 };
+};
+
+//! Statistics of the io_uring transport.
+struct UringStats {
+    //! The number of @p io_uring_enter system calls.
+    std::size_t enters;
+
+    //! The number of @p Send calls.
+    std::size_t sends;
+
+    //! The number of receive completions.
+    std::size_t recv_completions;
+};
+
+/**
+ * @brief The io_uring transport of a connected socket.
+ *
+ * @details
+ * It does not own the socket and it is not thread-safe.
+ */
+class UringTransport final {
+public:
+    /**
+     * @brief Create a transport and arm the receive.
+     *
+     * @param id A connected socket handle.
+     * @param options Options.
+     *
+     * @exception std::invalid_argument The options are invalid.
+     * @exception std::system_error The initialization failed.
+     */
+    UringTransport(SocketId id, const UringOptions& options);
+
+    //! Cancel pending operations and release the ring.
+    ~UringTransport() noexcept;
+
+    UringTransport(const UringTransport&) = delete;
+
+    UringTransport& operator=(const UringTransport&) = delete;
+
+    /**
+     * @brief Queue data to be sent by the next flush.
+     *
+     * @return The size of queued data, which is always the size of @p data.
+     *
+     * @exception std::system_error A previous operation failed.
+     */
+    std::size_t Send(std::span<const std::byte> data);
+
+    /**
+     * @brief Receive data.
+     *
+     * @details Queued data is flushed before waiting.
+     *
+     * @param buffer A buffer storing data. The function tries to fill this buffer.
+     * @return The size of received data, or @p 0 if the connection has been closed.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    std::size_t Recv(std::span<std::byte> buffer);
+
+    /**
+     * @brief Submit queued data and collect completions without waiting.
+     *
+     * @exception std::system_error The operation failed.
+     */
+    void Flush();
+
+    //! Get statistics.
+    const UringStats& Stats() const noexcept;
+
+private:
+    //! The user data of completions.
+    enum class Tag : std::uint64_t { Recv = 1, Send, Cancel };
+
+    //! A part of a receive buffer filled by the kernel.
+    struct Chunk {
+        std::uint16_t id;
+        std::uint32_t offset;
+        std::uint32_t size;
+    };
+
+    //! Map rings and register receive buffers.
+    void Setup();
+
+    //! Unmap rings and close the ring.
+    void Release() noexcept;
+
+    //! Get a free submission queue entry.
+    io_uring_sqe& NextSqe();
+
+    /**
+     * @brief Submit queued entries.
+     *
+     * @param min_complete The number of completions to wait for.
+     */
+    void Enter(std::uint32_t min_complete);
+
+    //! Handle all available completions.
+    void Reap() noexcept;
+
+    void Complete(const io_uring_cqe& cqe) noexcept;
+
+    //! Arm a multishot receive.
+    void ArmRecv();
+
+    //! Move queued data in flight and submit a send.
+    void PrepareSend();
+
+    //! Queue a send entry for the remaining data in flight.
+    void QueueSend();
+
+    //! Give a receive buffer back to the kernel.
+    void Recycle(std::uint16_t id) noexcept;
+
+    std::byte* BufferAt(std::uint16_t id) noexcept;
+
+    //! Throw the error of a previous operation.
+    void ThrowIfFailed() const;
+
+    SocketId socket_;
+
+    UringOptions options_;
+
+    int ring_{ -1 };
+
+    void* sq_ring_{ nullptr };
+    std::size_t sq_ring_size_{ 0 };
+
+    void* cq_ring_{ nullptr };
+    std::size_t cq_ring_size_{ 0 };
+
+    io_uring_sqe* sqes_{ nullptr };
+    std::size_t sqes_size_{ 0 };
+
+    std::uint32_t* sq_head_{ nullptr };
+    std::uint32_t* sq_tail_{ nullptr };
+    std::uint32_t* sq_array_{ nullptr };
+    std::uint32_t sq_mask_{ 0 };
+    std::uint32_t sq_entries_{ 0 };
+
+    //! The submission queue tail not yet published to the kernel.
+    std::uint32_t sq_local_tail_{ 0 };
+    std::uint32_t to_submit_{ 0 };
+
+    std::uint32_t* cq_head_{ nullptr };
+    std::uint32_t* cq_tail_{ nullptr };
+    std::uint32_t cq_mask_{ 0 };
+    io_uring_cqe* cqes_{ nullptr };
+
+    /**
+     * @brief The ring of registered receive buffers.
+     *
+     * @details
+     * @p io_uring_buf_ring is not used, because its flexible array has a different offset in C++.
+     * The ring tail overlaps the reserved field of the first entry.
+     */
+    io_uring_buf* buf_ring_{ nullptr };
+    std::size_t buf_ring_size_{ 0 };
+    std::uint16_t buf_tail_{ 0 };
+    std::vector<std::byte> buffers_{};
+
+    //! Received data not yet consumed by @p Recv.
+    std::deque<Chunk> ready_{};
+
+    bool recv_armed_{ false };
+    bool eof_{ false };
+
+    //! The error code of a failed operation.
+    int error_{ 0 };
+
+    //! Data queued by @p Send.
+    std::vector<std::byte> pending_{};
+
+    //! Data submitted to the kernel.
+    std::vector<std::byte> inflight_{};
+    std::size_t inflight_sent_{ 0 };
+    bool send_in_flight_{ false };
+
+    UringStats stats_{};
+};
+
+/**
+ * @brief The TCP socket using the io_uring transport.
+ *
+ * @details
+ * It has the same @p Send and @p Recv surface as @p TcpSocket,
+ * but data is not sent until @p Flush or @p Recv is called.
+ *
+ * @tparam ADDR An IP address.
+ */
+template <ValidIpAddr ADDR>
+class UringSocket final {
+public:
+    /**
+     * @brief Take over a connected TCP socket.
+     *
+     * @exception std::invalid_argument The options are invalid.
+     * @exception std::system_error The initialization failed.
+     */
+    explicit UringSocket(TcpSocket<ADDR> socket,
+                         const UringOptions& options = {});
+
+    //! Check if the socket is valid.
+    bool Valid() const noexcept;
+
+    //! Get the low-level socket handle.
+    SocketId ID() const noexcept;
+
+    //! @copydoc UringTransport::Send
+    std::size_t Send(std::span<const std::byte> data);
+
+    /**
+     * @brief Queue data in several buffers to be sent by the next flush.
+     *
+     * @return The total size of queued data.
+     *
+     * @exception std::system_error A previous operation failed.
+     */
+    std::size_t Send(std::span<const std::span<const std::byte>> buffers);
+
+    //! @copydoc UringTransport::Recv
+    std::size_t Recv(std::span<std::byte> buffer);
+
+    //! @copydoc UringTransport::Flush
+    void Flush();
+
+    //! Get statistics.
+    const UringStats& Stats() const noexcept;
+
+private:
+    TcpSocket<ADDR> socket_;
+
+    //! It must be destroyed before the socket to cancel pending operations.
+    std::unique_ptr<UringTransport> transport_;
+};
+
+
+template <ValidIpAddr ADDR>
+UringSocket<ADDR>::UringSocket(TcpSocket<ADDR> socket,
+                               const UringOptions& options) :
+    socket_{ std::move(socket) },
+    transport_{ std::make_unique<UringTransport>(socket_.ID(), options) } {}
+
+template <ValidIpAddr ADDR>
+bool UringSocket<ADDR>::Valid() const noexcept {
+    return socket_.Valid();
+}
+
+template <ValidIpAddr ADDR>
+SocketId UringSocket<ADDR>::ID() const noexcept {
+    return socket_.ID();
+}
+
+template <ValidIpAddr ADDR>
+std::size_t UringSocket<ADDR>::Send(const std::span<const std::byte> data) {
+    return transport_->Send(data);
+}
+
+template <ValidIpAddr ADDR>
+std::size_t UringSocket<ADDR>::Send(
+    const std::span<const std::span<const std::byte>> buffers) {
+    std::size_t size{ 0 };
+    for (const auto buffer : buffers) {
+        size += transport_->Send(buffer);
+    }
+
+    return size;
+}
+
+template <ValidIpAddr ADDR>
+std::size_t UringSocket<ADDR>::Recv(const std::span<std::byte> buffer) {
+    return transport_->Recv(buffer);
+}
+
+template <ValidIpAddr ADDR>
+void UringSocket<ADDR>::Flush() {
+    transport_->Flush();
+}
+
+template <ValidIpAddr ADDR>
+const UringStats& UringSocket<ADDR>::Stats() const noexcept {
+    return transport_->Stats();
+}
+
+}  // namespace net
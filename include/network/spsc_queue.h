@@ -0,0 +1,128 @@
+/**
+ * @file spsc_queue.h
+ * @brief The lock-free single-producer single-consumer queue.
+ *
+ * @details
+ * A queue is a bounded ring of slots with a head moved by the consumer and a tail moved by the producer.
+ * Both indices are on their own cache lines, and each side caches the other's index,
+ * so the line is only shared again when the queue looks full or empty.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+
+namespace net {
+
+//! The size of a cache line, which separates data written by different threads.
+inline constexpr std::size_t cache_line_size{ 64 };
+
+/**
+ * @brief The lock-free single-producer single-consumer queue.
+ *
+ * @details
+ * @p TryPush must only be called by one thread and @p TryPop by another one.
+ *
+ * @tparam T A trivially copyable element.
+ * @tparam CAPACITY The maximum number of elements, which must be a power of two.
+ */
+template <typename T, std::size_t CAPACITY>
+class SpscQueue final {
+public:
+    static_assert(std::has_single_bit(CAPACITY),
+                  "The capacity must be a power of two.");
+    static_assert(std::is_trivially_copyable_v<T>
+                  && std::is_default_constructible_v<T>);
+
+    //! The maximum number of elements.
+    static constexpr std::size_t capacity{ CAPACITY };
+
+    SpscQueue() noexcept = default;
+
+    SpscQueue(const SpscQueue&) = delete;
+
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Append an element on the producer thread.
+     *
+     * @param val An element.
+     * @return Whether it has been appended, or @p false if the queue is full.
+     */
+    bool TryPush(const T& val) noexcept {
+        const auto tail{ tail_.load(std::memory_order_relaxed) };
+        if (tail - cached_head_ == capacity) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == capacity) {
+                return false;
+            }
+        }
+
+        slots_[tail & (capacity - 1)] = val;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest element on the consumer thread.
+     *
+     * @return An element, or an empty value if the queue is empty.
+     */
+    std::optional<T> TryPop() noexcept {
+        const auto head{ head_.load(std::memory_order_relaxed) };
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return std::nullopt;
+            }
+        }
+
+        const auto val{ slots_[head & (capacity - 1)] };
+        head_.store(head + 1, std::memory_order_release);
+        return val;
+    }
+
+    //! Get the number of elements, which may be outdated when it returns.
+    std::size_t Size() const noexcept {
+        // The head is loaded first, so it never passes the tail.
+        const auto head{ head_.load(std::memory_order_acquire) };
+        return tail_.load(std::memory_order_acquire) - head;
+    }
+
+    //! Check if the queue is empty, which may be outdated when it returns.
+    bool Empty() const noexcept {
+        return Size() == 0;
+    }
+
+private:
+    //! The index of the next element to take, written by the consumer.
+    alignas(cache_line_size) std::atomic<std::size_t> head_{ 0 };
+
+    //! The tail last seen by the consumer.
+    std::size_t cached_tail_{ 0 };
+
+    //! The index of the next slot to fill, written by the producer.
+    alignas(cache_line_size) std::atomic<std::size_t> tail_{ 0 };
+
+    //! The head last seen by the producer.
+    std::size_t cached_head_{ 0 };
+
+    alignas(cache_line_size) std::array<T, capacity> slots_{};
+};
+
+}  // namespace net
@@ -0,0 +1,303 @@
+/**
+ * @file stream_reader.h
+ * @brief The buffered reader of packet streams.
+ *
+ * @details
+ * A reader receives as much data as the socket has with one call,
+ * and hands out in-place views of every complete packet in its buffer.
+ * Partial packets are kept and completed by following reads.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include "async.h"
+#include "packet.h"
+#include "socket/tcp.h"
+#include "varint.h"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <vector>
+
+
+namespace net {
+
+/**
+ * @brief The way packets are delimited in a stream.
+ *
+ * @details
+ * @p FrameSize gets the size of the first packet including its prefix,
+ * or an empty value if the prefix is incomplete.
+ * A prefix is never longer than @p max_prefix_size,
+ * so data of that size without a readable prefix is malformed.
+ * A framing can also check each complete packet with a static @p Check method.
+ */
+template <typename T>
+concept Framing = requires(const std::span<const std::byte> data) {
+    { T::max_prefix_size } -> std::convertible_to<std::size_t>;
+    { T::FrameSize(data) } -> std::same_as<std::optional<std::size_t>>;
+};
+
+//! Packets starting with a @p Header.
+struct HeaderFraming {
+    static constexpr std::size_t max_prefix_size{ sizeof(Header) };
+
+    static std::optional<std::size_t> FrameSize(
+        const std::span<const std::byte> data) noexcept {
+        if (data.size_bytes() < sizeof(Header)) {
+            return std::nullopt;
+        }
+
+        const auto header{ LoadHeader(data) };
+        return header.size > std::numeric_limits<std::size_t>::max()
+                                 - sizeof(Header)
+                   ? std::numeric_limits<std::size_t>::max()
+                   : sizeof(Header) + header.size;
+    }
+
+    /**
+     * @brief Check a complete packet.
+     *
+     * @exception std::invalid_argument The header is invalid.
+     */
+    static void Check(const std::span<const std::byte> packet) {
+        Verify(packet);
+    }
+};
+
+//! Packets starting with a variable-length size of the following data.
+struct VarintFraming {
+    static constexpr std::size_t max_prefix_size{ max_varint_size };
+
+    static std::optional<std::size_t> FrameSize(
+        const std::span<const std::byte> data) noexcept {
+        const auto prefix{ ReadVarint(data) };
+        if (!prefix.has_value()) {
+            return std::nullopt;
+        }
+
+        const auto [size, prefix_size]{ prefix.value() };
+        return size > std::numeric_limits<std::size_t>::max() - prefix_size
+                   ? std::numeric_limits<std::size_t>::max()
+                   : prefix_size + static_cast<std::size_t>(size);
+    }
+};
+
+/**
+ * @brief The buffered reader of a packet stream.
+ *
+ * @details
+ * The buffer is contiguous, so every packet can be viewed in place.
+ * Unread data is moved to the front before each read, which only copies a partial packet.
+ * The buffer never grows beyond the initial capacity or the maximum packet size, whichever is larger,
+ * so a peer cannot make it allocate without limit.
+ *
+ * @tparam SOCKET A stream socket.
+ * @tparam FRAMING The way packets are delimited.
+ */
+template <StreamSocket SOCKET, Framing FRAMING = HeaderFraming>
+class StreamReader final {
+public:
+    //! The default initial capacity of the buffer.
+    static constexpr std::size_t default_capacity{ 4096 };
+
+    //! The default maximum size of a packet, including its header.
+    static constexpr std::size_t default_max_packet_size{ 64 * 1024 };
+
+    /**
+     * @brief Create a reader.
+     *
+     * @param socket A connected socket. It must outlive the reader.
+     * @param capacity The initial capacity of the buffer.
+     * @param max_packet_size The maximum size of a packet, including its header.
+     *
+     * @exception std::invalid_argument The capacity or the maximum size is too small.
+     */
+    explicit StreamReader(SOCKET& socket,
+                          std::size_t capacity = default_capacity,
+                          std::size_t max_packet_size = default_max_packet_size);
+
+    /**
+     * @brief Receive as much data as the socket has with one call.
+     *
+     * @details Views returned by @p Next become invalid.
+     *
+     * @return The size of received data, or @p 0 if the connection has been closed.
+     *
+     * @exception std::runtime_error A packet is too large or malformed, or the buffer is full of packets that have not been taken.
+     * @exception std::system_error The operation failed.
+     */
+    std::size_t Fill();
+
+    /**
+     * @brief Receive as much data as the socket has with one call in a coroutine.
+     *
+     * @details Views returned by @p Next become invalid.
+     *
+     * @param stop_token A token cancelling the operation.
+     * @return The size of received data, or @p 0 if the connection has been closed.
+     *
+     * @exception std::runtime_error A packet is too large or malformed, or the buffer is full of packets that have not been taken.
+     * @exception std::system_error The operation failed or has been cancelled.
+     */
+    Task<std::size_t> AsyncFill(std::stop_token stop_token = {})
+        requires AsyncStreamSocket<SOCKET>;
+
+    /**
+     * @brief Take the next complete packet in the buffer.
+     *
+     * @return A view of the packet including its header, which is valid until the next fill,
+     * or an empty value if there is no complete packet.
+     *
+     * @exception std::runtime_error The packet is too large or its prefix is malformed.
+     * @exception std::invalid_argument The packet is rejected by the framing.
+     */
+    std::optional<std::span<const std::byte>> Next();
+
+    //! Get the size of buffered data that has not been taken.
+    std::size_t Buffered() const noexcept;
+
+private:
+    /**
+     * @brief Get the size of the next packet.
+     *
+     * @return The packet size, or an empty value if its header is incomplete.
+     *
+     * @exception std::runtime_error The packet is too large or its prefix is malformed.
+     */
+    std::optional<std::size_t> NextPacketSize() const;
+
+    /**
+     * @brief Move unread data to the front and make room for the next packet.
+     *
+     * @return Free space after buffered data.
+     *
+     * @exception std::runtime_error The next packet is too large or malformed, or the buffer is full of packets that have not been taken.
+     */
+    std::span<std::byte> Prepare();
+
+    SOCKET& socket_;
+
+    std::size_t max_packet_size_;
+
+    std::vector<std::byte> buffer_;
+
+    //! The beginning of data that has not been taken.
+    std::size_t begin_{ 0 };
+
+    //! The end of received data.
+    std::size_t end_{ 0 };
+};
+
+
+template <StreamSocket SOCKET, Framing FRAMING>
+StreamReader<SOCKET, FRAMING>::StreamReader(
+    SOCKET& socket, const std::size_t capacity,
+    const std::size_t max_packet_size) :
+    socket_{ socket }, max_packet_size_{ max_packet_size } {
+    if (capacity < FRAMING::max_prefix_size
+        || max_packet_size < FRAMING::max_prefix_size) {
+        throw std::invalid_argument{ "The buffer size is too small." };
+    }
+
+    buffer_.resize(capacity);
+}
+
+template <StreamSocket SOCKET, Framing FRAMING>
+std::size_t StreamReader<SOCKET, FRAMING>::Fill() {
+    const auto received{ socket_.Recv(Prepare()) };
+    end_ += received;
+    return received;
+}
+
+template <StreamSocket SOCKET, Framing FRAMING>
+Task<std::size_t> StreamReader<SOCKET, FRAMING>::AsyncFill(
+    const std::stop_token stop_token)
+    requires AsyncStreamSocket<SOCKET>
+{
+    const auto received{ co_await socket_.AsyncRecv(Prepare(), stop_token) };
+    end_ += received;
+    co_return received;
+}
+
+template <StreamSocket SOCKET, Framing FRAMING>
+std::optional<std::span<const std::byte>>
+StreamReader<SOCKET, FRAMING>::Next() {
+    const auto size{ NextPacketSize() };
+    if (!size.has_value() || Buffered() < size.value()) {
+        return std::nullopt;
+    }
+
+    const std::span<const std::byte> pkg{ buffer_.data() + begin_,
+                                          size.value() };
+    if constexpr (requires { FRAMING::Check(pkg); }) {
+        FRAMING::Check(pkg);
+    }
+
+    begin_ += size.value();
+    return pkg;
+}
+
+template <StreamSocket SOCKET, Framing FRAMING>
+std::size_t StreamReader<SOCKET, FRAMING>::Buffered() const noexcept {
+    return end_ - begin_;
+}
+
+template <StreamSocket SOCKET, Framing FRAMING>
+std::optional<std::size_t>
+StreamReader<SOCKET, FRAMING>::NextPacketSize() const {
+    const auto size{ FRAMING::FrameSize(
+        std::span{ buffer_ }.subspan(begin_, Buffered())) };
+    if (!size.has_value()) {
+        if (Buffered() >= FRAMING::max_prefix_size) {
+            throw std::runtime_error{ "The packet prefix is malformed." };
+        }
+    } else if (size.value() > max_packet_size_) {
+        throw std::runtime_error{ "The packet is too large." };
+    }
+
+    return size;
+}
+
+template <StreamSocket SOCKET, Framing FRAMING>
+std::span<std::byte> StreamReader<SOCKET, FRAMING>::Prepare() {
+    if (begin_ != 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, Buffered());
+        end_ -= begin_;
+        begin_ = 0;
+    }
+
+    const auto needed{ NextPacketSize().value_or(FRAMING::max_prefix_size) };
+    if (buffer_.size() < needed) {
+        buffer_.resize(needed);
+    } else if (end_ == buffer_.size()) {
+        // Complete packets have not been taken.
+        if (buffer_.size() >= max_packet_size_) {
+            throw std::runtime_error{
+                "The buffer is full of packets that have not been taken."
+            };
+        }
+
+        buffer_.resize(std::min(buffer_.size() * 2, max_packet_size_));
+    }
+
+    return std::span{ buffer_ }.subspan(end_);
+}
+
+}  // namespace net
@@ -0,0 +1,98 @@
+/**
+ * @file varint.h
+ * @brief Variable-length integers.
+ *
+ * @details
+ * An unsigned integer is stored in little-endian groups of 7 bits,
+ * and the highest bit of each byte means more bytes follow.
+ * Signed integers are mapped to unsigned ones with zigzag encoding first,
+ * so small negative numbers are short too.
+ *
+ * @author Chen Zhenshuo (chenzs108@outlook.com)
+ * @author Liu Guowen (liu.guowen@outlook.com)
+ * @version 1.0
+ * @date 2026-10-17
+ * @par GitHub
+ * https://github.com/czs108
+ * @par
+ * https://github.com/lgw1995
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+
+namespace net {
+
+//! The maximum size of a variable-length 64-bit integer.
+inline constexpr std::size_t max_varint_size{ 10 };
+
+//! Get the encoded size of an unsigned integer.
+constexpr std::size_t VarintSize(std::uint64_t val) noexcept {
+    std::size_t size{ 1 };
+    while (val >= 0x80) {
+        val >>= 7;
+        ++size;
+    }
+
+    return size;
+}
+
+/**
+ * @brief Encode an unsigned integer.
+ *
+ * @param val A value.
+ * @param buffer A buffer of at least @p VarintSize(val) bytes.
+ * @return The encoded size.
+ */
+constexpr std::size_t WriteVarint(std::uint64_t val,
+                                  const std::span<std::byte> buffer) noexcept {
+    std::size_t size{ 0 };
+    while (val >= 0x80) {
+        buffer[size++] = static_cast<std::byte>((val & 0x7F) | 0x80);
+        val >>= 7;
+    }
+
+    buffer[size++] = static_cast<std::byte>(val);
+    return size;
+}
+
+/**
+ * @brief Decode an unsigned integer.
+ *
+ * @param buffer A buffer starting with an encoded value.
+ * @return The value and its encoded size,
+ * or an empty value if the buffer is incomplete or the value is too long.
+ */
+constexpr std::optional<std::pair<std::uint64_t, std::size_t>> ReadVarint(
+    const std::span<const std::byte> buffer) noexcept {
+    std::uint64_t val{ 0 };
+    for (std::size_t i{ 0 }; i != buffer.size() && i != max_varint_size; ++i) {
+        const auto byte{ static_cast<std::uint64_t>(buffer[i]) };
+        val |= (byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            return std::pair{ val, i + 1 };
+        }
+    }
+
+    return std::nullopt;
+}
+
+//! Map a signed integer to an unsigned one, keeping small magnitudes small.
+constexpr std::uint64_t ZigZagEncode(const std::int64_t val) noexcept {
+    return (static_cast<std::uint64_t>(val) << 1)
+           ^ static_cast<std::uint64_t>(val >> 63);
+}
+
+//! Restore a signed integer mapped by @p ZigZagEncode.
+constexpr std::int64_t ZigZagDecode(const std::uint64_t val) noexcept {
+    return static_cast<std::int64_t>(val >> 1)
+           ^ -static_cast<std::int64_t>(val & 1);
+}
+
+}  // namespace net
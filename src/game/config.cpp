@@ -33,6 +33,44 @@ Network::Network(const std::string_view file) noexcept {
 
     port_ = GetPrivateProfileIntA(ini_section.data(), port_ini_key.data(),
                                   default_port, file.data());
+
+    char profile[64]{};
+    if (const auto profile_size{ GetPrivateProfileStringA(
+            ini_section.data(), profile_ini_key.data(), "", profile,
+            sizeof(profile), file.data()) };
+        profile_size != 0) {
+        profile_ = profile;
+    }
+
+    connect_timeout_ = std::chrono::milliseconds{ GetPrivateProfileIntA(
+        ini_section.data(), connect_timeout_ini_key.data(),
+        static_cast<INT>(default_connect_timeout.count()), file.data()) };
+
+    batch_delay_ = std::chrono::microseconds{ GetPrivateProfileIntA(
+        ini_section.data(), batch_delay_ini_key.data(),
+        static_cast<INT>(default_batch_delay.count()), file.data()) };
+
+    compact_encoding_ = GetPrivateProfileIntA(
+                            ini_section.data(), compact_encoding_ini_key.data(),
+                            default_compact_encoding, file.data())
+                        != 0;
+
+    checksum_ = GetPrivateProfileIntA(ini_section.data(),
+                                      checksum_ini_key.data(), default_checksum,
+                                      file.data())
+                != 0;
+
+    input_delay_ = std::chrono::milliseconds{ GetPrivateProfileIntA(
+        ini_section.data(), input_delay_ini_key.data(),
+        static_cast<INT>(default_input_delay.count()), file.data()) };
+
+    char late_policy[64]{};
+    if (const auto late_policy_size{ GetPrivateProfileStringA(
+            ini_section.data(), late_policy_ini_key.data(), "", late_policy,
+            sizeof(late_policy), file.data()) };
+        late_policy_size != 0) {
+        late_policy_ = late_policy;
+    }
 }
 
 
@@ -44,6 +82,34 @@ std::uint16_t Network::Port() const noexcept {
     return port_;
 }
 
+std::string_view Network::Profile() const noexcept {
+    return profile_;
+}
+
+std::chrono::milliseconds Network::ConnectTimeout() const noexcept {
+    return connect_timeout_;
+}
+
+std::chrono::microseconds Network::BatchDelay() const noexcept {
+    return batch_delay_;
+}
+
+bool Network::CompactEncoding() const noexcept {
+    return compact_encoding_;
+}
+
+bool Network::Checksum() const noexcept {
+    return checksum_;
+}
+
+std::chrono::milliseconds Network::InputDelay() const noexcept {
+    return input_delay_;
+}
+
+std::string_view Network::LatePolicy() const noexcept {
+    return late_policy_;
+}
+
 }  // namespace cfg
 
 
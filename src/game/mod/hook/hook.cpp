@@ -4,15 +4,14 @@
 #include "state.h"
 
 #include "system/memory.h"
-#include "network/listener.h"
+#include "system/windows_error.h"
 #include "network/packet.h"
 #include "network/socket/tcp.h"
 
 #include <cassert>
+#include <chrono>
 #include <exception>
 #include <format>
-#include <thread>
-#include <typeinfo>
 #include <utility>
 
 
@@ -20,6 +19,63 @@ namespace game::mod::hook {
 
 using namespace sys;
 
+namespace {
+
+void CALLBACK ApplyOnTimer(HWND, UINT, UINT_PTR, DWORD) noexcept {
+    netpkg::ApplyReceived();
+}
+
+}  // namespace
+
+
+std::uintptr_t ApplyEvents::timer_{ 0 };
+
+std::string_view ApplyEvents::Name() const noexcept {
+    return "Apply-Events";
+}
+
+void ApplyEvents::Enable() {
+    if (timer_ != 0) {
+        return;
+    }
+
+    timer_ = SetTimer(nullptr, 0, interval_ms, ApplyOnTimer);
+    if (timer_ == 0) {
+        ThrowLastError();
+    }
+}
+
+void ApplyEvents::Disable() {
+    if (timer_ == 0) {
+        return;
+    }
+
+    KillTimer(nullptr, std::exchange(timer_, 0));
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    const auto stats{ state::inbound.Stats() };
+    const auto mean{ stats.applied != 0
+                         ? stats.total_latency
+                               / static_cast<std::int64_t>(stats.applied)
+                         : stats.total_latency };
+    const auto msg{ std::format(
+        "Applied {} received events with a mean latency of {} and a maximum "
+        "of {}. Queued events reached a depth of {}.",
+        stats.applied, duration_cast<microseconds>(mean),
+        duration_cast<microseconds>(stats.max_latency), stats.max_depth) };
+    OutputDebugStringA(msg.c_str());
+
+    const auto& lockstep{ state::lockstep.Stats() };
+    const auto lockstep_msg{ std::format(
+        "Applied {} received events on the lockstep timeline. {} arrived "
+        "late, and the timeline stalled {} times and fell behind the clock by "
+        "up to {} ticks.",
+        lockstep.remote, lockstep.late, lockstep.stalls, lockstep.max_lag) };
+    OutputDebugStringA(lockstep_msg.c_str());
+}
+
+
 Hook::Trampoline BeforeLoadLevel::HookBytes() const noexcept {
     return { .code{ call, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 },
                     std::byte{ 0 }, nop },
@@ -61,59 +117,48 @@ __declspec(naked) void __stdcall BeforeLoadLevel::Detour() noexcept {
 
 void __stdcall BeforeLoadLevel::Callback() noexcept {
     netpkg::StopRecvLoop(true);
+    state::inbound.Clear();
 
     Loader loader{};
-    loader.Add(std::make_unique<DisableAutoPause>())
+    loader.Add(std::make_unique<ApplyEvents>())
+        .Add(std::make_unique<DisableAutoPause>())
         .Add(std::make_unique<DisableRuntimeMenu>())
-        .Add(std::make_unique<LevelEnd>())
-        .Add(std::make_unique<CreateZombie>());
+        .Add(std::make_unique<LevelEnd>());
 
+    // Both players place items with the same call, which is hooked by role.
     if (state::role == Role::Plant) {
         loader.Add(std::make_unique<CreatePlant>());
+    } else {
+        loader.Add(std::make_unique<CreateZombie>());
     }
 
     try {
+        const auto policy{ netpkg::LatePolicyFromName(
+            state::cfg.Network().LatePolicy()) };
+
         loader.Load();
+        // The game is paused until the connection has been set up.
+        netpkg::StartRecvLoop().get();
 
-        if (state::role == Role::Plant) {
-            net::Listener<cfg::IpAddr> listener{};
-
-            std::string_view ip{};
-            if (typeid(cfg::IpAddr) == typeid(net::Ipv4Addr)) {
-                ip = net::Ipv4Addr::any;
-            } else if (typeid(cfg::IpAddr) == typeid(net::Ipv6Addr)) {
-                ip = net::Ipv6Addr::any;
-            } else {
-                assert(false);
-                std::abort();
-            }
-
-            listener.Bind(cfg::IpAddr{ ip, state::cfg.Network().Port() });
-            listener.Listen();
-            state::conn = std::make_unique<net::TcpSocket<cfg::IpAddr>>(
-                listener.Accept());
-
-        } else if (state::role == Role::Zombie) {
-            state::conn = std::make_unique<net::TcpSocket<cfg::IpAddr>>();
-            state::conn->Connect(cfg::IpAddr{ state::cfg.Network().ServerIp(),
-                                              state::cfg.Network().Port() });
-        } else {
-            assert(false);
-            std::abort();
-        }
+        // The timeline starts when the game is resumed and first applies events.
+        state::lockstep = netpkg::LockstepScheduler{
+            state::role,
+            { .input_delay{ state::input_delay }, .policy{ policy } }
+        };
 
     } catch (const std::exception& err) {
+        netpkg::StopRecvLoop(true);
+        state::batcher.reset();
         state::conn.reset();
         const auto msg{ std::format("Failed to start an online battle: {}",
                                     err.what()) };
         OutputDebugStringA(msg.c_str());
         MessageBoxA(nullptr, msg.c_str(), "Online Battle", MB_ICONERROR);
-        return;
     }
 
-    state::recv_thread.stop_src = std::make_unique<std::stop_source>();
-    state::recv_thread.thread = std::make_unique<std::jthread>(
-        netpkg::RecvLoop, state::recv_thread.stop_src->get_token());
+    // The connection has waited for the lookup started by prefetching,
+    // so its thread is joined quickly and outside the loader lock.
+    state::resolver.Join();
 }
 
 
@@ -303,17 +348,14 @@ void __stdcall LevelEnd::Callback() noexcept {
         return;
     }
 
-    netpkg::Header lvl_end{};
-    lvl_end.size = sizeof(lvl_end);
-    lvl_end.pkt_type = netpkg::Type::LevelEnd;
-    lvl_end.role = state::role;
+    auto lvl_end{ netpkg::LevelEndMessage::Make(state::role) };
 
     try {
-        net::Packet pkg{};
-        pkg.Write({ reinterpret_cast<std::byte*>(&lvl_end), sizeof(lvl_end) });
-        pkg.Send(*state::conn);
+        netpkg::Send(lvl_end);
 
+        // The packet is sent before the connection is closed.
         netpkg::StopRecvLoop(true);
+        ApplyEvents{}.Disable();
 
     } catch (const std::exception& err) {
         const auto msg{ std::format("Failed to send a packet: {}",
@@ -343,20 +385,10 @@ __declspec(naked) void __stdcall LevelEnd::Detour() noexcept {
 
 
 Hook::Trampoline CreateZombie::HookBytes() const noexcept {
-    if (state::role == Role::Plant) {
-        return { .code{ call, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 },
-                        std::byte{ 0 } },
-                 .jmp_offset_pos{ sizeof(call) },
-                 .jmp_inst_len{ call_len } };
-    } else if (state::role == Role::Zombie) {
-        return { .code{ jmp, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 },
-                        std::byte{ 0 }, nop },
-                 .jmp_offset_pos{ sizeof(jmp) },
-                 .jmp_inst_len{ jmp_len } };
-    } else {
-        assert(false);
-        std::abort();
-    }
+    return { .code{ call, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 },
+                    std::byte{ 0 } },
+             .jmp_offset_pos{ sizeof(call) },
+             .jmp_inst_len{ call_len } };
 }
 
 
@@ -365,61 +397,33 @@ std::string_view CreateZombie::Name() const noexcept {
 }
 
 std::intptr_t CreateZombie::From() const noexcept {
-    if (state::role == Role::Plant) {
-        return 0x0042A425;
-    } else if (state::role == Role::Zombie) {
-        return FUNC_CREATE_ZOMBIE_ADDR;
-    } else {
-        assert(false);
-        std::abort();
-    }
+    // The call placing an item when the player clicks the lawn.
+    return 0x0042A425;
 }
 
-
 std::intptr_t CreateZombie::To() const noexcept {
-    if (state::role == Role::Plant) {
-        return reinterpret_cast<std::intptr_t>(PlantDetour);
-    } else if (state::role == Role::Zombie) {
-        return reinterpret_cast<std::intptr_t>(ZombieDetour);
-    } else {
-        assert(false);
-        std::abort();
-    }
-}
-
-
-std::optional<std::intptr_t> CreateZombie::JumpRet() const noexcept {
-    if (state::role == Role::Plant) {
-        return std::nullopt;
-    } else if (state::role == Role::Zombie) {
-        return GetFuncEntryAddr(To()) + zombie_detour_len - jmp_len;
-    } else {
-        assert(false);
-        std::abort();
-    }
+    return reinterpret_cast<std::intptr_t>(Detour);
 }
 
-
-void __stdcall CreateZombie::ZombieCallback(const std::int32_t pos_x,
-                                            const std::int32_t pos_y,
-                                            const std::int32_t id) noexcept {
-    if (state::conn == nullptr || !state::conn->Valid()) {
-        return;
-    }
-
-    netpkg::NewItem new_item{};
-    new_item.size = sizeof(new_item);
-    new_item.pkt_type = netpkg::Type::NewZombie;
-    new_item.role = Role::Zombie;
-    new_item.pos_x = pos_x;
-    new_item.pos_y = pos_y;
-    new_item.id = id;
-
+void __stdcall CreateZombie::Callback(const std::int32_t pos_x,
+                                      const std::int32_t pos_y,
+                                      const std::int32_t id) noexcept {
     try {
-        net::Packet pkg{};
-        pkg.Write(
-            { reinterpret_cast<std::byte*>(&new_item), sizeof(new_item) });
-        pkg.Send(*state::conn);
+        if (state::conn == nullptr || !state::conn->Valid()) {
+            // Without a peer, the zombie is created at once.
+            mod::CreateZombie(pos_x, pos_y, id);
+            return;
+        }
+
+        // The timeline creates the zombie at the same tick as the peer.
+        // It is only scheduled once it has been queued for the peer.
+        const auto new_item{ netpkg::NewZombieMessage::Make(
+            Role::Zombie, pos_x, pos_y, id, state::lockstep.NextTick()) };
+        netpkg::Send(new_item);
+        state::lockstep.Schedule({ .type{ netpkg::Type::NewZombie },
+                                   .pos_x{ pos_x },
+                                   .pos_y{ pos_y },
+                                   .id{ id } });
 
     } catch (const std::exception& err) {
         const auto msg{ std::format("Failed to send a packet: {}",
@@ -429,53 +433,25 @@ void __stdcall CreateZombie::ZombieCallback(const std::int32_t pos_x,
 }
 
 
-__declspec(naked) void __stdcall CreateZombie::ZombieDetour() noexcept {
+__declspec(naked) void __stdcall CreateZombie::Detour() noexcept {
     __asm {
         pushad
         push    dword ptr ss : [esp + 32 + 4]
         push    eax
         push    dword ptr ss : [esp + 32 + 16]
-        mov     eax, ZombieCallback
+        mov     eax, Callback
         call    eax
         popad
-
-        push    ebx
-        push    ebp
-        mov     ebp, dword ptr ss : [esp + 0xC]
-        // jmp
-        nop
-        nop
-        nop
-        nop
-        nop
-    }
-}
-
-
-__declspec(naked) void __stdcall CreateZombie::PlantDetour() noexcept {
-    __asm {
-        pushad
-        mov     edx, dword ptr ss : [esp + 32 + 4]
-        mov     ebx, dword ptr ss : [esp + 32 + 8]
-        push    -1
-        push    edx
-        push    ebx
-        mov     ebx, dword ptr ds : [BASE_ADDR]
-        mov     ebx, dword ptr ds : [ebx + 0x768]
-        push    ebx
-        mov     edx, FUNC_CREATE_PLANT_ADDR
-        call    edx
-        popad
         retn    8
     }
 }
 
 
 Hook::Trampoline CreatePlant::HookBytes() const noexcept {
-    return { .code{ jmp, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 },
-                    std::byte{ 0 }, nop, nop },
-             .jmp_offset_pos{ sizeof(jmp) },
-             .jmp_inst_len{ jmp_len } };
+    return { .code{ call, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 },
+                    std::byte{ 0 } },
+             .jmp_offset_pos{ sizeof(call) },
+             .jmp_inst_len{ call_len } };
 }
 
 
@@ -484,37 +460,34 @@ std::string_view CreatePlant::Name() const noexcept {
 }
 
 std::intptr_t CreatePlant::From() const noexcept {
-    return FUNC_CREATE_PLANT_ADDR;
+    // The call placing an item when the player clicks the lawn.
+    return 0x0042A425;
 }
 
 std::intptr_t CreatePlant::To() const noexcept {
     return reinterpret_cast<std::intptr_t>(Detour);
 }
 
-std::optional<std::intptr_t> CreatePlant::JumpRet() const noexcept {
-    return GetFuncEntryAddr(To()) + detour_len - jmp_len;
-}
-
 void __stdcall CreatePlant::Callback(const std::int32_t pos_x,
                                      const std::int32_t pos_y,
                                      const std::int32_t id) noexcept {
-    if (state::conn == nullptr || !state::conn->Valid()) {
-        return;
-    }
+    try {
+        if (state::conn == nullptr || !state::conn->Valid()) {
+            // Without a peer, the plant is created at once.
+            mod::CreatePlant(pos_x, pos_y, id);
+            return;
+        }
 
-    netpkg::NewItem new_item{};
-    new_item.size = sizeof(new_item);
-    new_item.pkt_type = netpkg::Type::NewPlant;
-    new_item.role = Role::Plant;
-    new_item.pos_x = pos_x;
-    new_item.pos_y = pos_y;
-    new_item.id = id;
+        // The timeline creates the plant at the same tick as the peer.
+        // It is only scheduled once it has been queued for the peer.
+        const auto new_item{ netpkg::NewPlantMessage::Make(
+            Role::Plant, pos_x, pos_y, id, state::lockstep.NextTick()) };
+        netpkg::Send(new_item);
+        state::lockstep.Schedule({ .type{ netpkg::Type::NewPlant },
+                                   .pos_x{ pos_x },
+                                   .pos_y{ pos_y },
+                                   .id{ id } });
 
-    try {
-        net::Packet pkg{};
-        pkg.Write(
-            { reinterpret_cast<std::byte*>(&new_item), sizeof(new_item) });
-        pkg.Send(*state::conn);
     } catch (const std::exception& err) {
         const auto msg{ std::format("Failed to send a packet: {}",
                                     err.what()) };
@@ -526,23 +499,13 @@ void __stdcall CreatePlant::Callback(const std::int32_t pos_x,
 __declspec(naked) void __stdcall CreatePlant::Detour() noexcept {
     __asm {
         pushad
-        push    dword ptr ss : [esp + 32 + 12]
+        push    dword ptr ss : [esp + 32 + 4]
         push    eax
         push    dword ptr ss : [esp + 32 + 16]
         mov     eax, Callback
         call    eax
         popad
-
-        push    ecx
-        push    ebx
-        push    ebp
-        mov     ebp, dword ptr ss : [esp + 0x10]
-        // jmp
-        nop
-        nop
-        nop
-        nop
-        nop
+        retn    8
     }
 }
 
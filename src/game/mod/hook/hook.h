@@ -24,6 +24,35 @@
 
 namespace game::mod::hook {
 
+/**
+ * @brief Apply received events on the game thread.
+ *
+ * @details
+ * A timer of the game thread drains the inbound queue and runs the lockstep timeline.
+ * It is dispatched by the game's message loop, so events never race with the game.
+ *
+ * The timer is not tied to game updates.
+ * @p WM_TIMER messages are low-priority, coalesced and rounded up to the system timer resolution,
+ * so a callback may come late or cover several ticks.
+ * The lockstep timeline follows the wall clock instead of counting callbacks,
+ * and each callback runs all ticks that are due, so a late callback only delays events.
+ */
+class ApplyEvents : public Mod {
+public:
+    void Enable() override;
+
+    void Disable() override;
+
+    std::string_view Name() const noexcept override;
+
+private:
+    //! The requested interval of the timer in milliseconds, which only sets how often due ticks are polled.
+    static constexpr std::uint32_t interval_ms{ 10 };
+
+    //! The timer ID, or @p 0 if the timer has not been set.
+    static std::uintptr_t timer_;
+};
+
 //! The hook procedure before loading an online level.
 class BeforeLoadLevel : public Hook {
 public:
@@ -125,7 +154,13 @@ private:
     static void __stdcall Detour() noexcept;
 };
 
-//! The hook procedure when creating a zombie.
+/**
+ * @brief The hook procedure when the zombie player places a zombie.
+ *
+ * @details
+ * It replaces the game's call creating the zombie.
+ * The zombie is scheduled on the lockstep timeline instead, which creates it at the same tick as the peer.
+ */
 class CreateZombie : public Hook {
 public:
     std::string_view Name() const noexcept;
@@ -137,20 +172,20 @@ protected:
 
     std::intptr_t To() const noexcept override;
 
-    std::optional<std::intptr_t> JumpRet() const noexcept override;
-
 private:
-    static constexpr std::size_t zombie_detour_len{ 0x20 };
-
-    static void __stdcall ZombieDetour() noexcept;
-
-    static void __stdcall PlantDetour() noexcept;
+    static void __stdcall Detour() noexcept;
 
-    static void __stdcall ZombieCallback(std::int32_t pos_x, std::int32_t pos_y,
-                                         std::int32_t id) noexcept;
+    static void __stdcall Callback(std::int32_t pos_x, std::int32_t pos_y,
+                                   std::int32_t id) noexcept;
 };
 
-//! The hook procedure when creating a plant.
+/**
+ * @brief The hook procedure when the plant player places a plant.
+ *
+ * @details
+ * The plant player places items with the same call as the zombie player.
+ * It replaces the call, and the plant is scheduled on the lockstep timeline.
+ */
 class CreatePlant : public Hook {
 public:
     std::string_view Name() const noexcept;
@@ -162,11 +197,7 @@ protected:
 
     std::intptr_t To() const noexcept override;
 
-    std::optional<std::intptr_t> JumpRet() const noexcept override;
-
 private:
-    static constexpr std::size_t detour_len{ 0x21 };
-
     static void __stdcall Detour() noexcept;
 
     static void __stdcall Callback(std::int32_t pos_x, std::int32_t pos_y,
@@ -3,70 +3,431 @@
 #include "mod/interface.h"
 #include "state.h"
 
+#include "netpkg/codec.h"
+#include "netpkg/dispatch.h"
+#include "network/connector.h"
+#include "network/listener.h"
+#include "network/packet_view.h"
+#include "network/stream_reader.h"
+
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
 #include <format>
+#include <limits>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
 
 
 namespace game::netpkg {
 
-void Process(const Header* const packet) {
-    assert(packet != nullptr);
+void GameBackend::CreatePlant(const std::int32_t pos_x,
+                              const std::int32_t pos_y, const std::int32_t id) {
+    mod::CreatePlant(pos_x, pos_y, id);
+}
+
+void GameBackend::CreateZombie(const std::int32_t pos_x,
+                               const std::int32_t pos_y,
+                               const std::int32_t id) {
+    mod::CreateZombie(pos_x, pos_y, id);
+}
+
+void GameBackend::EndLevel() {
+    mod::hook::LevelEnd{}.Disable();
+    mod::hook::ApplyEvents{}.Disable();
+    mod::EndLevel();
+}
+
+
+namespace {
+
+/**
+ * @brief The capacity of the receive buffer, which holds a burst of game events.
+ *
+ * @details
+ * It covers the largest packet of either encoding, so the buffer is allocated once and never grows,
+ * whatever the peer sends.
+ */
+constexpr std::size_t recv_capacity{ 4096 };
+
+static_assert(recv_capacity >= Messages::max_size
+                  && recv_capacity >= CompactEncoder::max_packet_size,
+              "The receive buffer must hold the largest packet.");
+
+//! The time the receiver thread waits for the game thread to take events from a full queue.
+constexpr std::chrono::milliseconds drain_wait{ 1 };
+
+/**
+ * @brief The session of the receiver thread.
+ *
+ * @param stop_token A token cancelling the session.
+ * @param connected A promise fulfilled when the connection has been set up or failed.
+ */
+net::Task<> Session(const std::stop_token stop_token,
+                    std::promise<void> connected) {
+    try {
+        co_await Connect(stop_token);
+        connected.set_value();
+    } catch (...) {
+        connected.set_exception(std::current_exception());
+        state::recv_thread.ended.store(true, std::memory_order_release);
+        net::Executor::Current().Stop();
+        co_return;
+    }
+
+    try {
+        co_await RecvLoop(stop_token);
+    } catch (const std::exception& err) {
+        const auto msg{ std::format("Failed to receive or process a packet: {}",
+                                    err.what()) };
+        OutputDebugStringA(msg.c_str());
+    }
+
+    // The connection is closed by StopRecvLoop after both threads end.
+    state::recv_thread.ended.store(true, std::memory_order_release);
+    net::Executor::Current().Stop();
+}
+
+void RunRecvThread(const std::stop_token stop_token,
+                   std::promise<void> connected) noexcept {
+    assert(state::recv_thread.reactor != nullptr);
 
-    switch (packet->pkt_type) {
-        case Type::NewPlant: {
-            const NewItem* const item = static_cast<const NewItem*>(packet);
-            mod::CreatePlant(item->pos_x, item->pos_y, item->id);
-            break;
+    try {
+        net::Executor executor{ *state::recv_thread.reactor };
+        executor.Spawn(Session(stop_token, std::move(connected)));
+        executor.Run();
+    } catch (const std::exception& err) {
+        const auto msg{ std::format("The receiver thread failed: {}",
+                                    err.what()) };
+        OutputDebugStringA(msg.c_str());
+    }
+}
+
+/**
+ * @brief Encode a packet as negotiated and append it to the batch.
+ *
+ * @param packet A packet in the fixed layout. Its size, flags, sequence number and checksum are filled in.
+ *
+ * @exception std::invalid_argument The packet cannot be encoded.
+ * @exception std::system_error The operation failed.
+ */
+void Transmit(const std::span<std::byte> packet) {
+    // Compact packets have no header, and the stream carries no checksums.
+    if (state::encoding == Encoding::Fixed
+        && state::cfg.Network().Checksum()) {
+        packet[offsetof(net::Header, flags)]
+            |= static_cast<std::byte>(net::HeaderFlag::Checksum);
+    }
+
+    const auto seq{ ++state::send_seq };
+    std::memcpy(packet.data() + offsetof(net::Header, seq), &seq,
+                sizeof(seq));
+    net::Seal(packet);
+
+    if (state::encoding == Encoding::Compact) {
+        std::array<std::byte, CompactEncoder::max_packet_size> buffer{};
+        const auto size{ state::encoder.Encode(packet, buffer) };
+        state::batcher->Append(std::span{ buffer }.first(size));
+    } else {
+        state::batcher->Append(packet);
+    }
+}
+
+//! Send all queued packets in a batch on the sender thread.
+void SendQueued() noexcept {
+    try {
+        state::outbound.Drain(Transmit);
+        state::batcher->Flush();
+    } catch (const std::exception& err) {
+        const auto msg{ std::format("Failed to send a packet: {}",
+                                    err.what()) };
+        OutputDebugStringA(msg.c_str());
+    }
+}
+
+/**
+ * @brief Send queued packets until the thread is requested to stop.
+ *
+ * @details Packets queued before the request are still sent.
+ *
+ * @param stop_token A token stopping the thread.
+ */
+void RunSendThread(const std::stop_token stop_token) noexcept {
+    assert(state::batcher != nullptr);
+
+    const auto delay{ state::batcher->Delay() };
+    while (!stop_token.stop_requested()) {
+        state::outbound.Wait(stop_token);
+
+        // Packets queued during the delay are sent in the same batch.
+        if (delay != std::chrono::microseconds::zero()
+            && !stop_token.stop_requested()) {
+            std::this_thread::sleep_for(delay);
         }
-        case Type::NewZombie: {
-            const NewItem* const item = static_cast<const NewItem*>(packet);
-            mod::CreateZombie(item->pos_x, item->pos_y, item->id);
-            break;
+
+        SendQueued();
+    }
+
+    SendQueued();
+}
+
+/**
+ * @brief Exchange @p Hello packets, and choose the encoding and the input delay.
+ *
+ * @param stop_token A token cancelling the operation.
+ *
+ * @exception std::runtime_error The connection has been closed or the peer did not say hello.
+ * @exception std::system_error The operation failed or has been cancelled.
+ */
+net::Task<> Handshake(const std::stop_token stop_token) {
+    const auto& network{ state::cfg.Network() };
+    const auto input_delay{ static_cast<Tick>(
+        network.InputDelay() / LockstepOptions::default_tick_interval) };
+    auto hello{ HelloMessage::Make(
+        state::role, static_cast<std::uint32_t>(Encoding::Fixed),
+        input_delay) };
+    // Compact packets have no header to carry a checksum, so checksums win.
+    if (network.CompactEncoding() && network.Checksum()) {
+        OutputDebugStringA("The compact encoding is not offered "
+                           "because checksums are enabled.");
+    } else if (network.CompactEncoding()) {
+        hello.encodings |= static_cast<std::uint32_t>(Encoding::Compact);
+    }
+
+    net::Packet::Send(*state::conn, hello);
+
+    // A peer cannot make us allocate more than the largest message.
+    const auto pkg{ co_await net::Packet::AsyncRecv(*state::conn, stop_token,
+                                                    Messages::max_size) };
+    const auto peer{ net::PacketView<Hello>::From(pkg.Read()) };
+    if (!peer.has_value() || TypeOf(peer->Bytes()) != Type::Hello) {
+        throw std::runtime_error{ "The peer did not say hello." };
+    }
+
+    state::encoding = Negotiate(hello.encodings, peer->Get(&Hello::encodings));
+    state::encoder = {};
+    state::send_seq = 0;
+
+    // Both sides must use the same delay, so the larger one covers both.
+    state::input_delay = std::max(input_delay, peer->Get(&Hello::input_delay));
+}
+
+/**
+ * @brief End a session whose receiver thread has stopped on the game thread.
+ *
+ * @details
+ * The connection is closed, so later items are created at once.
+ * The peer sends no more events, so the timeline stops waiting for its promises.
+ */
+void EndSession() noexcept {
+    StopRecvLoop(true);
+    state::lockstep.Confirm(std::numeric_limits<Tick>::max());
+    OutputDebugStringA("The connection to the peer has been lost.");
+}
+
+/**
+ * @brief Receive and process packets with a reader until the connection is closed.
+ *
+ * @details
+ * While the inbound queue is full, no packet is processed and no data is read,
+ * so TCP flow control slows the peer down instead of events being lost.
+ *
+ * @param reader A stream reader.
+ * @param process A function processing a received packet.
+ * @param stop_token A token cancelling the operation.
+ */
+template <typename READER, typename PROCESS>
+net::Task<> Pump(READER& reader, PROCESS process,
+                 const std::stop_token stop_token) {
+    // A burst of packets is received with one call and processed in place.
+    // Their space is reused by the next fill, so memory stays constant.
+    while (true) {
+        if (co_await reader.AsyncFill(stop_token) == 0) {
+            throw std::runtime_error{ "The connection has been closed." };
         }
-        case Type::LevelEnd: {
-            mod::hook::LevelEnd{}.Disable();
-            mod::EndLevel();
-            break;
+
+        while (const auto pkg{ reader.Next() }) {
+            while (state::inbound.Full()) {
+                co_await net::Executor::Current().Sleep(drain_wait, stop_token);
+            }
+
+            process(*pkg);
         }
-        default: {
-            throw std::invalid_argument{ "The type of packet is unknown." };
+    }
+}
+
+}  // namespace
+
+
+void Send(const std::span<const std::byte> packet) {
+    state::outbound.Push(packet);
+}
+
+
+net::Task<> Connect(const std::stop_token stop_token) {
+    if (state::role == Role::Plant) {
+        net::Listener<cfg::IpAddr> listener{};
+
+        // A dual-stack server accepts both versions.
+        // It falls back to IPv4 if IPv6 is not available.
+        const auto port{ state::cfg.Network().Port() };
+        try {
+            listener.Bind(cfg::IpAddr{ net::Ipv6Addr::any, port });
+        } catch (const std::system_error&) {
+            listener.Bind(cfg::IpAddr{ net::Ipv4Addr::any, port });
         }
+
+        listener.Listen();
+        state::conn = std::make_unique<net::TcpSocket<cfg::IpAddr>>(
+            co_await listener.AsyncAccept(stop_token));
+
+    } else if (state::role == Role::Zombie) {
+        // The address has usually been resolved when the game started.
+        // IPv6 and IPv4 addresses of the server are raced.
+        const auto& network{ state::cfg.Network() };
+        state::conn = std::make_unique<net::TcpSocket<cfg::IpAddr>>(
+            co_await net::AsyncConnectHost(
+                state::resolver, std::string{ network.ServerIp() },
+                network.Port(), { .timeout{ network.ConnectTimeout() } },
+                stop_token));
+    } else {
+        assert(false);
+        std::abort();
     }
+
+    state::conn->Apply(
+        net::LatencyProfile::FromName(state::cfg.Network().Profile()));
+    co_await Handshake(stop_token);
+    state::batcher
+        = std::make_unique<net::Batcher<net::TcpSocket<cfg::IpAddr>>>(
+            *state::conn, state::cfg.Network().BatchDelay());
+    state::send_thread = std::make_unique<std::jthread>(RunSendThread);
 }
 
+net::Task<> RecvLoop(const std::stop_token stop_token) {
+    assert(state::conn != nullptr);
+
+    // The game is changed on its own thread, so events are only queued here.
+    EventDispatcher<InboundQueue> dispatcher{ state::inbound };
+    const auto process{ [&dispatcher](const std::span<const std::byte> pkg) {
+        dispatcher.Dispatch(pkg);
+    } };
+
+    try {
+        if (state::encoding == Encoding::Compact) {
+            // Compact packets are restored to the fixed layout before processing.
+            net::StreamReader<net::TcpSocket<cfg::IpAddr>, net::VarintFraming>
+                reader{ *state::conn, recv_capacity,
+                        CompactEncoder::max_packet_size };
+            CompactDecoder decoder{};
+            co_await Pump(
+                reader,
+                [&decoder, &process](const std::span<const std::byte> pkg) {
+                    // A malformed packet is passed on as an empty one, so the dispatcher counts it.
+                    std::array<std::byte, Messages::max_size> buffer;
+                    std::span<const std::byte> decoded{};
+                    try {
+                        decoded = decoder.Decode(pkg, buffer);
+                    } catch (const std::invalid_argument&) {
+                    }
+
+                    process(decoded);
+                },
+                stop_token);
+        } else {
+            net::StreamReader reader{ *state::conn, recv_capacity,
+                                      Messages::max_size };
+            co_await Pump(reader, process, stop_token);
+        }
+    } catch (...) {
+        const auto msg{ std::format(
+            "Skipped {} packets of unknown types and {} malformed packets. "
+            "Queued events reached a depth of {}.",
+            dispatcher.Unknown(), dispatcher.Malformed(),
+            state::inbound.MaxDepth()) };
+        OutputDebugStringA(msg.c_str());
+        throw;
+    }
+}
 
-void RecvLoop(const std::stop_token stop_token) noexcept {
+void ApplyReceived() noexcept {
     try {
-        while (!stop_token.stop_requested()) {
-            net::Packet pkg{ net::Packet::Recv(*state::conn) };
-            Process(reinterpret_cast<const Header*>(pkg.Read().data()));
+        // Events queued before the session ended are still applied.
+        const auto ended{ state::recv_thread.ended.load(
+            std::memory_order_acquire) };
+        state::inbound.Drain(state::lockstep);
+        if (ended && state::conn != nullptr && state::conn->Valid()) {
+            EndSession();
         }
+
+        GameBackend game{};
+        state::lockstep.Update(
+            LockstepScheduler::Clock::now(), game,
+            [](const Heartbeat& heartbeat) {
+                if (state::conn != nullptr && state::conn->Valid()) {
+                    Send(heartbeat);
+                }
+            });
     } catch (const std::exception& err) {
-        const auto msg{ std::format("Failed to receive or process a packet: {}",
+        const auto msg{ std::format("Failed to apply a received event: {}",
                                     err.what()) };
         OutputDebugStringA(msg.c_str());
     }
+}
 
-    StopRecvLoop(false);
+std::future<void> StartRecvLoop() {
+    state::recv_thread.reactor = std::make_unique<net::Reactor>();
+    state::recv_thread.ended.store(false, std::memory_order_relaxed);
+
+    std::promise<void> connected{};
+    auto future{ connected.get_future() };
+    state::recv_thread.thread
+        = std::make_unique<std::jthread>(RunRecvThread, std::move(connected));
+    return future;
 }
 
 
-void StopRecvLoop(bool wait) noexcept {
-    if (state::recv_thread.stop_src != nullptr) {
-        state::recv_thread.stop_src->request_stop();
-    }
+void StopRecvLoop(const bool wait) noexcept {
+    // The sender thread sends queued packets before the connection is closed.
+    if (state::send_thread != nullptr) {
+        state::send_thread->request_stop();
+        if (wait) {
+            if (state::send_thread->joinable()) {
+                state::send_thread->join();
+            }
 
-    if (state::conn != nullptr) {
-        state::conn->Close();
+            state::send_thread.reset();
+        }
     }
 
-    if (wait && state::recv_thread.thread != nullptr
-        && state::recv_thread.thread->joinable()) {
-        state::recv_thread.thread->join();
+    // Pending operations are cancelled and the session stops the event loop.
+    if (state::recv_thread.thread != nullptr) {
+        state::recv_thread.thread->request_stop();
     }
 
-    state::recv_thread.stop_src.reset();
+    if (wait) {
+        if (state::recv_thread.thread != nullptr
+            && state::recv_thread.thread->joinable()) {
+            state::recv_thread.thread->join();
+        }
+
+        state::recv_thread.thread.reset();
+        state::recv_thread.reactor.reset();
+
+        // No other thread uses the connection now.
+        if (state::conn != nullptr) {
+            state::conn->Close();
+        }
+    }
 }
 
 }  // namespace game::netpkg
\ No newline at end of file
@@ -16,58 +16,117 @@
 
 #include "config.h"
 
-#include "network/packet.h"
+#include "netpkg/message.h"
+#include "network/async.h"
 
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
-#include <thread>
+#include <future>
+#include <span>
+#include <stop_token>
 
 
 namespace game::netpkg {
 
-//! Types of packets.
-enum class Type { NewPlant, NewZombie, LevelEnd };
+//! The game as the backend of received events, which must only be used on the game thread.
+struct GameBackend {
+    void CreatePlant(std::int32_t pos_x, std::int32_t pos_y, std::int32_t id);
 
-//! The header of a packet.
-struct alignas(std::int32_t) Header : public net::Header {
-    //! The type.
-    Type pkt_type;
+    void CreateZombie(std::int32_t pos_x, std::int32_t pos_y, std::int32_t id);
 
-    //! The player's role.
-    Role role;
+    void EndLevel();
 };
 
-//! The packet storing a creation event.
-struct alignas(std::int32_t) NewItem : public Header {
-    //! The X-coordinate of the target location.
-    std::int32_t pos_x;
+/**
+ * @brief Queue a packet to be sent.
+ *
+ * @details
+ * It only copies the packet, so the calling game thread never waits for the network.
+ * The sender thread encodes it as negotiated and batches it with other packets
+ * unless batching is disabled.
+ *
+ * @param packet A packet in the fixed layout.
+ *
+ * @exception std::length_error The packet is larger than any message.
+ * @exception std::runtime_error Too many packets are waiting.
+ */
+void Send(std::span<const std::byte> packet);
 
-    //! The X-coordinate of the target location.
-    std::int32_t pos_y;
+/**
+ * @brief Queue a packet to be sent.
+ *
+ * @tparam PACKET A packet derived from @p Header.
+ * @param packet A packet.
+ *
+ * @exception std::length_error The packet is larger than any message.
+ * @exception std::runtime_error Too many packets are waiting.
+ */
+template <std::derived_from<Header> PACKET>
+void Send(const PACKET& packet) {
+    Send(std::as_bytes(std::span{ &packet, 1 }));
+}
 
-    //! The item ID.
-    std::int32_t id;
-};
+/**
+ * @brief Set up the connection.
+ *
+ * @details
+ * The plant side waits for a client and the zombie side connects to the server.
+ * Then both sides exchange @p Hello packets to choose the encoding and the input delay,
+ * and the sender thread is started.
+ *
+ * @param stop_token A token cancelling the operation.
+ *
+ * @exception std::runtime_error The handshake failed.
+ * @exception std::system_error The operation failed or has been cancelled.
+ */
+net::Task<> Connect(std::stop_token stop_token);
 
 /**
- * @brief Process packets.
+ * @brief Receive packets until the connection is closed.
  *
- * @param packet A packet.
+ * @details
+ * Events are pushed into @p state::inbound and applied later by @p ApplyReceived.
+ * Packets of unknown types, too small sizes or broken compact encodings are skipped.
+ *
+ * @param stop_token A token cancelling the operation.
  *
- * @exception std::invalid_argument An unknown packet type.
+ * @exception std::runtime_error The connection has been closed.
+ * @exception std::system_error The operation failed or has been cancelled.
  */
-void Process(const Header* packet);
+net::Task<> RecvLoop(std::stop_token stop_token);
 
 /**
- * @brief The receiver thread.
+ * @brief Run the lockstep timeline, which must be called on the game thread.
  *
- * @param stop_token A stop token that can stop the thread.
+ * @details
+ * Received events are passed to @p state::lockstep,
+ * and events due by now are applied to the game.
+ * If the receiver thread has stopped, the session is ended,
+ * so the timeline no longer waits for the peer and later items are created at once.
  */
-void RecvLoop(std::stop_token stop_token) noexcept;
+void ApplyReceived() noexcept;
 
 /**
- * @brief Stop the receiver thread.
+ * @brief Start the receiver thread.
+ *
+ * @details
+ * The thread sets up the connection and then receives packets,
+ * with the event loop in @p state::recv_thread.
+ * It ends when the connection fails or the thread is requested to stop.
+ *
+ * @return A future that becomes ready when the connection has been set up or failed.
+ */
+std::future<void> StartRecvLoop();
+
+/**
+ * @brief Stop the receiver thread and the sender thread.
+ *
+ * @details
+ * If waiting, queued packets are sent, and the connection is closed after both threads end.
+ * Otherwise, the connection is left open, since the threads may still use it.
  *
- * @param wait Whether to wait for the thread to end.
+ * @param wait Whether to wait for the threads to end.
  */
 void StopRecvLoop(bool wait) noexcept;
 
@@ -3,6 +3,11 @@
 #include "mod/mod.h"
 #include "state.h"
 
+#include "system/windows_error.h"
+
+#include <Windows.h>
+
+#include <system_error>
 #include <utility>
 
 
@@ -18,6 +23,25 @@ Startup::~Startup() noexcept {
 }
 
 void Startup::Run() {
+    // Threads of the module are stopped on the game thread, never under the loader lock,
+    // so the module must not be unloaded while they run.
+    HMODULE module{ nullptr };
+    if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS
+                                | GET_MODULE_HANDLE_EX_FLAG_PIN,
+                            reinterpret_cast<LPCWSTR>(&state::role),
+                            &module)) {
+        sys::ThrowLastError();
+    }
+
+    // The server address is resolved in the background before the first level starts.
+    if (state::role == Role::Zombie) {
+        try {
+            const auto& network{ state::cfg.Network() };
+            state::resolver.Prefetch(network.ServerIp(), network.Port());
+        } catch (const std::system_error&) {
+        }
+    }
+
     mod::Loader{}
         .Add(std::make_unique<mod::AllowMultiProcess>())
         .Add(std::make_unique<mod::hook::BeforeLoadLevel>())
@@ -27,7 +51,11 @@ void Startup::Run() {
 
 
 void Startup::Stop() noexcept {
-    state::conn.reset();
+    // The module is pinned, so this only runs when the process exits, after
+    // other threads have been terminated. The session threads and what they
+    // use are only released on the game thread by netpkg::StopRecvLoop.
+    // The lookup thread started by prefetching is joined on the game thread
+    // when a level is loaded.
 }
 
 }  // namespace game
\ No newline at end of file
@@ -7,8 +7,28 @@ Role role{};
 
 Config cfg{};
 
+net::Resolver resolver{};
+
 std::unique_ptr<net::TcpSocket<cfg::IpAddr>> conn{};
 
-StoppableThread recv_thread{};
+std::unique_ptr<net::Batcher<net::TcpSocket<cfg::IpAddr>>> batcher{};
+
+netpkg::Encoding encoding{ netpkg::Encoding::Fixed };
+
+netpkg::CompactEncoder encoder{};
+
+std::uint32_t send_seq{ 0 };
+
+netpkg::InboundQueue inbound{};
+
+netpkg::Tick input_delay{ netpkg::LockstepOptions::default_input_delay };
+
+netpkg::LockstepScheduler lockstep{};
+
+netpkg::OutboundQueue outbound{};
+
+EventLoopThread recv_thread{};
+
+std::unique_ptr<std::jthread> send_thread{};
 
 }  // namespace game::state
\ No newline at end of file
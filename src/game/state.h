@@ -16,8 +16,17 @@
 
 #include "config.h"
 
+#include "netpkg/codec.h"
+#include "netpkg/inbound.h"
+#include "netpkg/lockstep.h"
+#include "netpkg/outbound.h"
+#include "network/batcher.h"
+#include "network/reactor.h"
+#include "network/resolver.h"
 #include "network/socket/tcp.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <thread>
 
@@ -30,19 +39,52 @@ extern Role role;
 //! The configuration.
 extern Config cfg;
 
+//! The resolver caching the server address.
+extern net::Resolver resolver;
+
 //! The network connection.
 extern std::unique_ptr<net::TcpSocket<cfg::IpAddr>> conn;
 
-//! The stoppable thread.
-struct StoppableThread {
+//! The batcher of outbound packets, which is only used by the sender thread and must be destroyed before the connection.
+extern std::unique_ptr<net::Batcher<net::TcpSocket<cfg::IpAddr>>> batcher;
+
+//! The encoding of packets negotiated with the peer.
+extern netpkg::Encoding encoding;
+
+//! The encoder of outbound packets if the compact encoding is used.
+extern netpkg::CompactEncoder encoder;
+
+//! The sequence number of the last sent packet, which is only used by the sender thread.
+extern std::uint32_t send_seq;
+
+//! Events received from the peer, which are applied on the game thread.
+extern netpkg::InboundQueue inbound;
+
+//! The input delay in ticks negotiated with the peer.
+extern netpkg::Tick input_delay;
+
+//! The timeline of events, which is only used on the game thread.
+extern netpkg::LockstepScheduler lockstep;
+
+//! Packets waiting to be sent by the sender thread.
+extern netpkg::OutboundQueue outbound;
+
+//! The thread running an event loop.
+struct EventLoopThread {
     //! The thread handle.
     std::unique_ptr<std::jthread> thread;
 
-    //! A stop source that can send a stop request.
-    std::unique_ptr<std::stop_source> stop_src;
+    //! The event loop. Stopping it wakes up the thread immediately.
+    std::unique_ptr<net::Reactor> reactor;
+
+    //! Whether the session has ended, which is set by the thread after it queues its last event.
+    std::atomic<bool> ended{ false };
 };
 
 //! The network communication thread.
-extern StoppableThread recv_thread;
+extern EventLoopThread recv_thread;
+
+//! The thread sending packets, which owns writes to the connection.
+extern std::unique_ptr<std::jthread> send_thread;
 
 }  // namespace game::state
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include "codec.h"
+
+#include "network/packet_view.h"
+#include "network/varint.h"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+
+namespace game::netpkg {
+
+namespace {
+
+constexpr std::uint8_t type_mask{ 0b00'1111 };
+constexpr std::uint8_t role_bit{ 0b01'0000 };
+constexpr std::uint8_t packed_bit{ 0b10'0000 };
+
+static_assert(Messages::max_type <= type_mask,
+              "A type tag must fit in the tag byte.");
+static_assert(CompactEncoder::max_packet_size - 1 < 0x80,
+              "The size of a compact packet must fit in one byte.");
+
+//! The reader of compact fields.
+class Reader {
+public:
+    explicit Reader(const std::span<const std::byte> data) noexcept :
+        data_{ data } {}
+
+    std::uint8_t Byte() {
+        if (data_.empty()) {
+            throw std::invalid_argument{ "The compact packet is truncated." };
+        }
+
+        const auto val{ static_cast<std::uint8_t>(data_.front()) };
+        data_ = data_.subspan(1);
+        return val;
+    }
+
+    std::uint64_t Varint() {
+        const auto val{ net::ReadVarint(data_) };
+        if (!val.has_value()) {
+            throw std::invalid_argument{ "The compact packet is truncated." };
+        }
+
+        data_ = data_.subspan(val->second);
+        return val->first;
+    }
+
+    std::int32_t Int32() {
+        const auto val{ net::ZigZagDecode(Varint()) };
+        if (val < std::numeric_limits<std::int32_t>::min()
+            || val > std::numeric_limits<std::int32_t>::max()) {
+            throw std::invalid_argument{ "A compact field is out of range." };
+        }
+
+        return static_cast<std::int32_t>(val);
+    }
+
+    //! Read the fields of a message.
+    template <typename MESSAGE>
+    typename MESSAGE::Layout Fields(const bool packed, const Role role) {
+        return MESSAGE::Read(data_, packed, role);
+    }
+
+    bool Empty() const noexcept {
+        return data_.empty();
+    }
+
+private:
+    std::span<const std::byte> data_;
+};
+
+}  // namespace
+
+
+Encoding Negotiate(const std::uint32_t local,
+                   const std::uint32_t remote) noexcept {
+    const auto common{ local & remote };
+    return (common & static_cast<std::uint32_t>(Encoding::Compact)) != 0
+               ? Encoding::Compact
+               : Encoding::Fixed;
+}
+
+
+std::size_t CompactEncoder::Encode(
+    const std::span<const std::byte> packet,
+    const std::span<std::byte, max_packet_size> buffer) {
+    const auto type{ TypeOf(packet) };
+    return Messages::Visit(type, [this, packet, buffer]<typename MESSAGE>() {
+        const auto msg{ MESSAGE::Load(packet) };
+        const auto packed{ MESSAGE::Packs(msg) };
+
+        auto tag{ static_cast<std::uint8_t>(MESSAGE::type) };
+        if (msg.role == Role::Zombie) {
+            tag |= role_bit;
+        }
+
+        if (packed) {
+            tag |= packed_bit;
+        }
+
+        // The body is written after a one-byte size.
+        std::size_t size{ 1 };
+        buffer[size++] = static_cast<std::byte>(tag);
+
+        // Packets are numbered in order, so the difference usually takes one byte.
+        const auto delta{ static_cast<std::int32_t>(msg.seq - seq_) };
+        size += net::WriteVarint(net::ZigZagEncode(delta),
+                                 buffer.subspan(size));
+        seq_ = msg.seq;
+
+        size += MESSAGE::Write(msg, packed, buffer.subspan(size));
+        buffer[0] = static_cast<std::byte>(size - 1);
+        return size;
+    });
+}
+
+std::uint32_t CompactEncoder::Sequence() const noexcept {
+    return seq_;
+}
+
+
+std::span<const std::byte> CompactDecoder::Decode(
+    const std::span<const std::byte> packet,
+    const std::span<std::byte, Messages::max_size> buffer) {
+    Reader reader{ packet };
+    if (reader.Varint() != packet.size_bytes() - 1) {
+        throw std::invalid_argument{
+            "The size of the compact packet is invalid."
+        };
+    }
+
+    const auto tag{ reader.Byte() };
+    if ((tag & ~(type_mask | role_bit | packed_bit)) != 0) {
+        throw std::invalid_argument{ "The compact packet is malformed." };
+    }
+
+    const auto type{ static_cast<Type>(tag & type_mask) };
+    const auto role{ (tag & role_bit) != 0 ? Role::Zombie : Role::Plant };
+    const auto packed{ (tag & packed_bit) != 0 };
+
+    const auto delta{ reader.Int32() };
+    const auto seq{ seq_ + static_cast<std::uint32_t>(delta) };
+
+    // The fields of an unknown type cannot be read, but its size is known, so it can be skipped.
+    if (!Messages::Has(type)) {
+        seq_ = seq;
+        net::StoreHeader({ .size{ 0 },
+                           .type{ static_cast<std::uint16_t>(type) },
+                           .seq{ seq } },
+                         buffer);
+        return buffer.first(sizeof(net::Header));
+    }
+
+    const auto size{ Messages::Visit(
+        type, [&reader, buffer, packed, role, seq]<typename MESSAGE>() {
+            auto msg{ reader.Fields<MESSAGE>(packed, role) };
+            msg.seq = seq;
+            std::memcpy(buffer.data(), &msg, sizeof(msg));
+            net::StoreHeader(msg, buffer);
+            return sizeof(msg);
+        }) };
+
+    if (!reader.Empty()) {
+        throw std::invalid_argument{ "The compact packet is malformed." };
+    }
+
+    seq_ = seq;
+    return buffer.first(size);
+}
+
+std::uint32_t CompactDecoder::Sequence() const noexcept {
+    return seq_;
+}
+
+}  // namespace game::netpkg
@@ -0,0 +1,59 @@
+#include "dictionary.h"
+#include "message.h"
+
+#include "network/compressor.h"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace game::netpkg {
+
+namespace {
+
+//! The number of lanes on the battlefield.
+constexpr std::int32_t lane_num{ 5 };
+
+//! Get the fixed layout of a message.
+template <typename MESSAGE>
+std::vector<std::byte> Bytes(const typename MESSAGE::Layout& msg) {
+    const auto bytes{ MESSAGE::Bytes(msg) };
+    return { bytes.begin(), bytes.end() };
+}
+
+std::vector<std::byte> Train() {
+    std::vector<std::vector<std::byte>> samples{};
+    for (const auto role : { Role::Plant, Role::Zombie }) {
+        samples.push_back(
+            Bytes<LevelEndMessage>(LevelEndMessage::Make(role)));
+        samples.push_back(
+            Bytes<HeartbeatMessage>(HeartbeatMessage::Make(role, 0)));
+
+        for (std::int32_t lane{ 0 }; lane != lane_num; ++lane) {
+            // Default slots hold the first items.
+            for (std::size_t id{ 0 }; id != slot_num; ++id) {
+                const auto item_id{ static_cast<std::int32_t>(id) };
+                samples.push_back(
+                    role == Role::Plant
+                        ? Bytes<NewPlantMessage>(
+                            NewPlantMessage::Make(role, 0, lane, item_id, 0))
+                        : Bytes<NewZombieMessage>(
+                            NewZombieMessage::Make(role, 0, lane, item_id, 0)));
+            }
+        }
+    }
+
+    const std::vector<std::span<const std::byte>> views{ samples.begin(),
+                                                         samples.end() };
+    return net::TrainDictionary(views);
+}
+
+}  // namespace
+
+
+std::span<const std::byte> CompressionDictionary() {
+    static const auto dictionary{ Train() };
+    return dictionary;
+}
+
+}  // namespace game::netpkg
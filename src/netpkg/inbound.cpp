@@ -0,0 +1,84 @@
+#include "inbound.h"
+
+#include <stdexcept>
+
+
+namespace game::netpkg {
+
+void InboundQueue::CreatePlant(const std::int32_t pos_x,
+                               const std::int32_t pos_y, const std::int32_t id,
+                               const Tick tick) {
+    Push({ .type{ Type::NewPlant },
+           .tick{ tick },
+           .pos_x{ pos_x },
+           .pos_y{ pos_y },
+           .id{ id },
+           .received{ Event::Clock::now() } });
+}
+
+void InboundQueue::CreateZombie(const std::int32_t pos_x,
+                                const std::int32_t pos_y, const std::int32_t id,
+                                const Tick tick) {
+    Push({ .type{ Type::NewZombie },
+           .tick{ tick },
+           .pos_x{ pos_x },
+           .pos_y{ pos_y },
+           .id{ id },
+           .received{ Event::Clock::now() } });
+}
+
+void InboundQueue::Confirm(const Tick tick) {
+    Push({ .type{ Type::Heartbeat },
+           .tick{ tick },
+           .received{ Event::Clock::now() } });
+}
+
+void InboundQueue::EndLevel() {
+    Push({ .type{ Type::LevelEnd }, .received{ Event::Clock::now() } });
+}
+
+std::size_t InboundQueue::Clear() noexcept {
+    std::size_t count{ 0 };
+    while (events_.TryPop()) {
+        ++count;
+    }
+
+    // Statistics are logged per level.
+    stats_ = {};
+    max_depth_.store(0, std::memory_order_relaxed);
+    return count;
+}
+
+std::size_t InboundQueue::Depth() const noexcept {
+    return events_.Size();
+}
+
+bool InboundQueue::Full() const noexcept {
+    // Only the receiver thread adds events, so the queue cannot become full after this.
+    return events_.Size() == capacity;
+}
+
+std::size_t InboundQueue::MaxDepth() const noexcept {
+    return max_depth_.load(std::memory_order_relaxed);
+}
+
+InboundStats InboundQueue::Stats() const noexcept {
+    auto stats{ stats_ };
+    stats.max_depth = MaxDepth();
+    return stats;
+}
+
+void InboundQueue::Push(const Event& event) {
+    // A lost event would make the boards differ for the rest of the level.
+    if (!events_.TryPush(event)) {
+        throw std::length_error{ "The inbound queue is full." };
+    }
+
+    // Only the receiver thread writes the maximum, so no compare-and-swap is needed.
+    const auto depth{ events_.Size() };
+    if (depth > max_depth_.load(std::memory_order_relaxed)) {
+        max_depth_.store(depth, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace game::netpkg
@@ -0,0 +1,135 @@
+#include "lockstep.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace game::netpkg {
+
+LatePolicy LatePolicyFromName(const std::string_view name) {
+    if (name == "Stall") {
+        return LatePolicy::Stall;
+    } else if (name == "Skip") {
+        return LatePolicy::Skip;
+    } else {
+        throw std::invalid_argument{ "The late policy is unknown." };
+    }
+}
+
+
+LockstepScheduler::LockstepScheduler() noexcept :
+    LockstepScheduler{ Role::Plant, {} } {}
+
+LockstepScheduler::LockstepScheduler(const Role role,
+                                     const LockstepOptions& options) noexcept :
+    role_{ role },
+    options_{ options },
+    heartbeat_interval_{ std::max<Tick>(options.input_delay / 2, 1) },
+    horizon_{ options.input_delay },
+    promised_{ options.input_delay } {}
+
+void LockstepScheduler::CreatePlant(const std::int32_t pos_x,
+                                    const std::int32_t pos_y,
+                                    const std::int32_t id, const Tick tick) {
+    Receive({ .type{ Type::NewPlant },
+              .tick{ tick },
+              .pos_x{ pos_x },
+              .pos_y{ pos_y },
+              .id{ id } });
+}
+
+void LockstepScheduler::CreateZombie(const std::int32_t pos_x,
+                                     const std::int32_t pos_y,
+                                     const std::int32_t id, const Tick tick) {
+    Receive({ .type{ Type::NewZombie },
+              .tick{ tick },
+              .pos_x{ pos_x },
+              .pos_y{ pos_y },
+              .id{ id } });
+}
+
+void LockstepScheduler::Confirm(const Tick tick) noexcept {
+    horizon_ = std::max(horizon_, tick);
+}
+
+void LockstepScheduler::EndLevel() noexcept {
+    level_end_ = true;
+}
+
+Tick LockstepScheduler::Schedule(Event event) {
+    event.tick = Stamp();
+    local_.push_back(event);
+    return event.tick;
+}
+
+Tick LockstepScheduler::NextTick() const noexcept {
+    // The stamp never decreases because the clock only moves forward.
+    // It does not follow a stalled timeline, or stalls on both sides would feed each other.
+    return due_ + options_.input_delay;
+}
+
+Tick LockstepScheduler::Stamp() noexcept {
+    promised_ = NextTick();
+    return promised_;
+}
+
+Tick LockstepScheduler::Current() const noexcept {
+    return tick_;
+}
+
+Tick LockstepScheduler::Horizon() const noexcept {
+    return horizon_;
+}
+
+const LockstepOptions& LockstepScheduler::Options() const noexcept {
+    return options_;
+}
+
+const LockstepStats& LockstepScheduler::Stats() const noexcept {
+    return stats_;
+}
+
+Tick LockstepScheduler::Target(const Clock::time_point now) noexcept {
+    if (!start_.has_value()) {
+        start_ = now;
+    }
+
+    // The first tick is due at the start.
+    const auto elapsed{ std::max(now - *start_, Clock::duration::zero()) };
+    return static_cast<Tick>(elapsed / options_.tick_interval) + 1;
+}
+
+std::optional<Event> LockstepScheduler::NextDue() noexcept {
+    // Both sides apply the plant side's events first.
+    auto& first{ role_ == Role::Plant ? local_ : remote_ };
+    auto& second{ role_ == Role::Plant ? remote_ : local_ };
+    for (auto* const events : { &first, &second }) {
+        if (!events->empty() && events->front().tick <= tick_) {
+            const auto event{ events->front() };
+            events->pop_front();
+            ++(events == &local_ ? stats_.local : stats_.remote);
+            return event;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<Heartbeat> LockstepScheduler::Promise() noexcept {
+    if (due_ + options_.input_delay < promised_ + heartbeat_interval_) {
+        return std::nullopt;
+    }
+
+    return HeartbeatMessage::Make(role_, Stamp());
+}
+
+void LockstepScheduler::Receive(const Event& event) {
+    if (event.tick < tick_) {
+        ++stats_.late;
+    }
+
+    horizon_ = std::max(horizon_, event.tick);
+    remote_.push_back(event);
+}
+
+}  // namespace game::netpkg
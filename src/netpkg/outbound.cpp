@@ -0,0 +1,56 @@
+#include "outbound.h"
+
+#include <cstring>
+#include <stdexcept>
+
+
+namespace game::netpkg {
+
+void OutboundQueue::Push(const std::span<const std::byte> packet) {
+    Record record;
+    if (packet.size_bytes() > record.data.size()) {
+        throw std::length_error{ "The packet is too large." };
+    }
+
+    std::memcpy(record.data.data(), packet.data(), packet.size_bytes());
+    record.size = static_cast<std::uint8_t>(packet.size_bytes());
+    if (!records_.TryPush(record)) {
+        throw std::runtime_error{ "The outbound queue is full." };
+    }
+
+    // The count is increased before checking the flag,
+    // so either the sender thread sees the new count or this thread sees the flag.
+    pushes_.fetch_add(1);
+    if (waiting_.load()) {
+        pushes_.notify_one();
+    }
+}
+
+void OutboundQueue::Wait(const std::stop_token stop_token) {
+    // A stop request wakes the thread up as a push does.
+    const auto wake{ [this] {
+        pushes_.fetch_add(1);
+        pushes_.notify_one();
+    } };
+    const std::stop_callback callback{ stop_token, wake };
+
+    while (!stop_token.stop_requested()) {
+        const auto pushes{ pushes_.load() };
+        if (!records_.Empty()) {
+            return;
+        }
+
+        waiting_.store(true);
+        if (records_.Empty()) {
+            pushes_.wait(pushes);
+        }
+
+        waiting_.store(false);
+    }
+}
+
+std::size_t OutboundQueue::Depth() const noexcept {
+    return records_.Size();
+}
+
+}  // namespace game::netpkg
@@ -0,0 +1,95 @@
+#include "snapshot.h"
+
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace game::netpkg {
+
+SnapshotRing::SnapshotRing(const std::size_t depth,
+                           const std::size_t capacity) :
+    capacity_{ capacity } {
+    if (depth == 0 || capacity == 0) {
+        throw std::invalid_argument{
+            "The depth and the capacity of snapshots must not be zero."
+        };
+    }
+
+    buffers_.resize(depth * capacity);
+    snapshots_.resize(depth);
+}
+
+void SnapshotRing::Save(
+    const Tick tick,
+    const std::initializer_list<std::span<const std::byte>> regions) {
+    std::size_t size{ 0 };
+    for (const auto region : regions) {
+        size += region.size_bytes();
+    }
+
+    if (size > capacity_) {
+        throw std::length_error{ "The snapshot is too large." };
+    }
+
+    assert(size_ == 0
+           || snapshots_[(head_ + size_ - 1) % Depth()].tick < tick);
+
+    // The oldest snapshot is overwritten if the ring is full.
+    if (size_ == Depth()) {
+        head_ = (head_ + 1) % Depth();
+        --size_;
+    }
+
+    const auto slot{ (head_ + size_) % Depth() };
+    auto buffer{ Buffer(slot) };
+    for (const auto region : regions) {
+        if (!region.empty()) {
+            std::memcpy(buffer.data(), region.data(), region.size_bytes());
+            buffer = buffer.subspan(region.size_bytes());
+        }
+    }
+
+    snapshots_[slot] = { .tick{ tick }, .size{ size } };
+    ++size_;
+}
+
+std::optional<std::span<const std::byte>> SnapshotRing::Rewind(
+    const Tick tick) noexcept {
+    // Snapshots are in the order of ticks, so the newest ones are checked first.
+    for (auto count{ size_ }; count != 0; --count) {
+        const auto slot{ (head_ + count - 1) % Depth() };
+        const auto& snapshot{ snapshots_[slot] };
+        if (snapshot.tick == tick) {
+            size_ = count - 1;
+            return Buffer(slot).first(snapshot.size);
+        } else if (snapshot.tick < tick) {
+            break;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void SnapshotRing::Clear() noexcept {
+    head_ = 0;
+    size_ = 0;
+}
+
+std::size_t SnapshotRing::Size() const noexcept {
+    return size_;
+}
+
+std::size_t SnapshotRing::Depth() const noexcept {
+    return snapshots_.size();
+}
+
+std::size_t SnapshotRing::Capacity() const noexcept {
+    return capacity_;
+}
+
+std::span<std::byte> SnapshotRing::Buffer(const std::size_t slot) noexcept {
+    return std::span{ buffers_ }.subspan(slot * capacity_, capacity_);
+}
+
+}  // namespace game::netpkg
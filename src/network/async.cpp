@@ -0,0 +1,360 @@
+#include "async.h"
+
+#include <cassert>
+#include <stdexcept>
+#include <system_error>
+
+
+namespace net {
+
+namespace {
+
+//! The executor running on the current thread.
+thread_local Executor* current_executor{ nullptr };
+
+//! Set the current executor in a scope.
+class CurrentGuard final {
+public:
+    explicit CurrentGuard(Executor& executor) noexcept :
+        prev_{ std::exchange(current_executor, &executor) } {}
+
+    ~CurrentGuard() noexcept {
+        current_executor = prev_;
+    }
+
+    CurrentGuard(const CurrentGuard&) = delete;
+
+    CurrentGuard& operator=(const CurrentGuard&) = delete;
+
+private:
+    Executor* prev_;
+};
+
+}  // namespace
+
+[[noreturn]] void ThrowCancelled() {
+    throw std::system_error{ std::make_error_code(
+        std::errc::operation_canceled) };
+}
+
+
+ReadinessAwaiter::ReadinessAwaiter(Executor& executor, const SocketId id,
+                                   const Event event,
+                                   std::stop_token stop_token) noexcept :
+    executor_{ executor },
+    id_{ id },
+    event_{ event },
+    stop_token_{ std::move(stop_token) } {}
+
+ReadinessAwaiter::~ReadinessAwaiter() noexcept {
+    on_stop_.reset();
+    if (pending_) {
+        executor_.Unwait(*this);
+    }
+}
+
+bool ReadinessAwaiter::await_ready() noexcept {
+    cancelled_ = stop_token_.stop_requested();
+    return cancelled_;
+}
+
+void ReadinessAwaiter::await_suspend(const std::coroutine_handle<> handle) {
+    handle_ = handle;
+    executor_.Wait(*this);
+    pending_ = true;
+    if (stop_token_.stop_possible()) {
+        on_stop_.emplace(stop_token_,
+                         Canceller{ &executor_, id_, event_, handle_ });
+    }
+}
+
+void ReadinessAwaiter::await_resume() const {
+    if (cancelled_) {
+        ThrowCancelled();
+    }
+}
+
+void ReadinessAwaiter::Canceller::operator()() const noexcept {
+    try {
+        executor->EventLoop().Post(
+            [executor{ executor }, id{ id }, event{ event }, handle{ handle }] {
+                executor->Cancel(id, event, handle);
+            });
+    } catch (...) {
+    }
+}
+
+
+SleepAwaiter::SleepAwaiter(Executor& executor,
+                           const Reactor::Clock::duration delay,
+                           std::stop_token stop_token) noexcept :
+    executor_{ executor },
+    delay_{ delay },
+    stop_token_{ std::move(stop_token) } {}
+
+SleepAwaiter::~SleepAwaiter() noexcept {
+    on_stop_.reset();
+    if (pending_) {
+        executor_.EventLoop().CancelTimer(timer_);
+        executor_.sleepers_.erase(timer_);
+    }
+}
+
+bool SleepAwaiter::await_ready() noexcept {
+    cancelled_ = stop_token_.stop_requested();
+    return cancelled_;
+}
+
+void SleepAwaiter::await_suspend(const std::coroutine_handle<> handle) {
+    handle_ = handle;
+    timer_ = executor_.EventLoop().AddTimer(delay_, [this] {
+        on_stop_.reset();
+        pending_ = false;
+        executor_.sleepers_.erase(timer_);
+        handle_.resume();
+    });
+
+    executor_.sleepers_.emplace(timer_, this);
+    pending_ = true;
+    if (stop_token_.stop_possible()) {
+        on_stop_.emplace(stop_token_, Canceller{ &executor_, timer_, handle_ });
+    }
+}
+
+void SleepAwaiter::await_resume() const {
+    if (cancelled_) {
+        ThrowCancelled();
+    }
+}
+
+void SleepAwaiter::Canceller::operator()() const noexcept {
+    try {
+        executor->EventLoop().Post(
+            [executor{ executor }, timer{ timer }, handle{ handle }] {
+                executor->Cancel(timer, handle);
+            });
+    } catch (...) {
+    }
+}
+
+
+Executor::Detached::promise_type::promise_type(Executor& executor,
+                                               Task<>&) noexcept :
+    executor{ executor } {}
+
+Executor::Detached
+Executor::Detached::promise_type::get_return_object() noexcept {
+    return { std::coroutine_handle<promise_type>::from_promise(*this) };
+}
+
+void Executor::Detached::promise_type::FinalAwaiter::await_suspend(
+    const std::coroutine_handle<promise_type> handle) const noexcept {
+    handle.promise().executor.tasks_.erase(handle.address());
+    handle.destroy();
+}
+
+void Executor::Detached::promise_type::unhandled_exception() const noexcept {
+    // Exceptions of tasks are caught by the driving coroutine.
+    assert(false);
+    std::terminate();
+}
+
+Executor::Detached Executor::Drive(Executor& executor, Task<> task) {
+    try {
+        co_await task;
+    } catch (...) {
+        if (executor.error_ == nullptr) {
+            executor.error_ = std::current_exception();
+            executor.Stop();
+        }
+    }
+}
+
+
+Executor::Executor(Reactor& reactor) noexcept : reactor_{ reactor } {}
+
+Executor::~Executor() noexcept {
+    // Destroying a driving coroutine destroys its task and unregisters pending waits.
+    while (!tasks_.empty()) {
+        const auto it{ tasks_.begin() };
+        const auto handle{ std::coroutine_handle<>::from_address(*it) };
+        tasks_.erase(it);
+        handle.destroy();
+    }
+}
+
+Reactor& Executor::EventLoop() const noexcept {
+    return reactor_;
+}
+
+void Executor::Spawn(Task<> task) {
+    const auto handle{ Drive(*this, std::move(task)).handle };
+    tasks_.insert(handle.address());
+    try {
+        reactor_.Post([this, handle] {
+            if (tasks_.contains(handle.address())) {
+                handle.resume();
+            }
+        });
+    } catch (...) {
+        tasks_.erase(handle.address());
+        handle.destroy();
+        throw;
+    }
+}
+
+void Executor::Run() {
+    const CurrentGuard guard{ *this };
+    reactor_.Run();
+    if (error_ != nullptr) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+void Executor::Stop() noexcept {
+    reactor_.Stop();
+}
+
+Executor& Executor::Current() {
+    if (current_executor == nullptr) {
+        throw std::logic_error{ "No executor is running." };
+    }
+
+    return *current_executor;
+}
+
+ReadinessAwaiter Executor::Readable(const SocketId id,
+                                    std::stop_token stop_token) {
+    return { *this, id, Event::Read, std::move(stop_token) };
+}
+
+ReadinessAwaiter Executor::Writable(const SocketId id,
+                                    std::stop_token stop_token) {
+    return { *this, id, Event::Write, std::move(stop_token) };
+}
+
+SleepAwaiter Executor::Sleep(const Reactor::Clock::duration delay,
+                             std::stop_token stop_token) {
+    return { *this, delay, std::move(stop_token) };
+}
+
+
+void Executor::Wait(ReadinessAwaiter& awaiter) {
+    const auto id{ awaiter.id_ };
+    const auto reading{ awaiter.event_ == Event::Read };
+    const auto it{ waiters_.find(id) };
+    if (it == waiters_.end()) {
+        reactor_.Watch(id, awaiter.event_, [this, id](const Event events) {
+            OnEvents(id, events);
+        });
+        waiters_.emplace(id, reading ? Waiters{ &awaiter, nullptr }
+                                     : Waiters{ nullptr, &awaiter });
+        return;
+    }
+
+    auto& slot{ reading ? it->second.reader : it->second.writer };
+    if (slot != nullptr) {
+        throw std::logic_error{
+            "Another coroutine is waiting for the same event of the socket."
+        };
+    }
+
+    reactor_.Modify(id, Event::Read | Event::Write);
+    slot = &awaiter;
+}
+
+void Executor::Unwait(ReadinessAwaiter& awaiter) noexcept {
+    awaiter.pending_ = false;
+
+    const auto id{ awaiter.id_ };
+    const auto it{ waiters_.find(id) };
+    assert(it != waiters_.end());
+    auto& [reader, writer] = it->second;
+    if (reader == &awaiter) {
+        reader = nullptr;
+    } else if (writer == &awaiter) {
+        writer = nullptr;
+    }
+
+    if (reader == nullptr && writer == nullptr) {
+        waiters_.erase(it);
+        reactor_.Unwatch(id);
+        return;
+    }
+
+    try {
+        reactor_.Modify(id, reader != nullptr ? Event::Read : Event::Write);
+    } catch (...) {
+        // Extra events only wake up the loop and are ignored by @p OnEvents.
+    }
+}
+
+void Executor::OnEvents(const SocketId id, const Event events) {
+    const auto it{ waiters_.find(id) };
+    if (it == waiters_.end()) {
+        return;
+    }
+
+    // Both coroutines are unregistered before resuming either of them.
+    const auto [reader, writer] = it->second;
+    std::coroutine_handle<> to_read{};
+    std::coroutine_handle<> to_write{};
+    if (reader != nullptr
+        && (HasEvent(events, Event::Read) || HasEvent(events, Event::Error))) {
+        reader->on_stop_.reset();
+        Unwait(*reader);
+        to_read = reader->handle_;
+    }
+
+    if (writer != nullptr
+        && (HasEvent(events, Event::Write) || HasEvent(events, Event::Error))) {
+        writer->on_stop_.reset();
+        Unwait(*writer);
+        to_write = writer->handle_;
+    }
+
+    if (to_read) {
+        to_read.resume();
+    }
+
+    if (to_write) {
+        to_write.resume();
+    }
+}
+
+void Executor::Cancel(const SocketId id, const Event event,
+                      const std::coroutine_handle<> handle) {
+    const auto it{ waiters_.find(id) };
+    if (it == waiters_.end()) {
+        return;
+    }
+
+    auto* const awaiter{ event == Event::Read ? it->second.reader
+                                              : it->second.writer };
+    if (awaiter == nullptr || awaiter->handle_ != handle) {
+        return;
+    }
+
+    awaiter->on_stop_.reset();
+    awaiter->cancelled_ = true;
+    Unwait(*awaiter);
+    handle.resume();
+}
+
+void Executor::Cancel(const Reactor::TimerId timer,
+                      const std::coroutine_handle<> handle) {
+    const auto it{ sleepers_.find(timer) };
+    if (it == sleepers_.end() || it->second->handle_ != handle) {
+        return;
+    }
+
+    auto* const awaiter{ it->second };
+    sleepers_.erase(it);
+    reactor_.CancelTimer(timer);
+    awaiter->on_stop_.reset();
+    awaiter->pending_ = false;
+    awaiter->cancelled_ = true;
+    handle.resume();
+}
+
+}  // namespace net
@@ -0,0 +1,70 @@
+#include "buffer_pool.h"
+
+#include <bit>
+
+
+namespace net {
+
+BufferPool::~BufferPool() noexcept {
+    for (auto& slots : free_) {
+        for (auto& slot : slots) {
+            delete[] slot.exchange(nullptr, std::memory_order_acquire);
+        }
+    }
+}
+
+BufferPool& BufferPool::Shared() noexcept {
+    static BufferPool pool{};
+    return pool;
+}
+
+std::span<std::byte> BufferPool::Acquire(const std::size_t size) {
+    if (size > max_block_size) {
+        return { new std::byte[size], size };
+    }
+
+    const auto cls{ SizeClass(size) };
+    const auto block_size{ min_block_size << cls };
+    for (auto& slot : free_[cls]) {
+        if (slot.load(std::memory_order_relaxed) == nullptr) {
+            continue;
+        } else if (const auto block{
+                       slot.exchange(nullptr, std::memory_order_acquire) };
+                   block != nullptr) {
+            return { block, block_size };
+        }
+    }
+
+    return { new std::byte[block_size], block_size };
+}
+
+void BufferPool::Release(const std::span<std::byte> block) noexcept {
+    if (block.empty()) {
+        return;
+    } else if (block.size() > max_block_size) {
+        delete[] block.data();
+        return;
+    }
+
+    for (auto& slot : free_[SizeClass(block.size())]) {
+        std::byte* expected{ nullptr };
+        if (slot.compare_exchange_strong(expected, block.data(),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+            return;
+        }
+    }
+
+    delete[] block.data();
+}
+
+std::size_t BufferPool::SizeClass(const std::size_t size) noexcept {
+    if (size <= min_block_size) {
+        return 0;
+    }
+
+    return static_cast<std::size_t>(std::bit_width(size - 1)
+                                    - std::bit_width(min_block_size - 1));
+}
+
+}  // namespace net
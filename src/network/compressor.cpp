@@ -0,0 +1,273 @@
+#include "compressor.h"
+#include "varint.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+
+namespace net {
+
+namespace {
+
+//! Get the last bytes of a dictionary that fit in the window.
+std::vector<std::byte> ClampDictionary(
+    const std::span<const std::byte> dictionary) {
+    const auto size{ std::min(dictionary.size(), compress_window) };
+    const auto last{ dictionary.last(size) };
+    return { last.begin(), last.end() };
+}
+
+}  // namespace
+
+
+std::vector<std::byte> TrainDictionary(
+    const std::span<const std::span<const std::byte>> samples,
+    const std::size_t max_size) {
+    // Identical samples are sorted next to each other and counted.
+    std::vector<std::span<const std::byte>> sorted{};
+    for (const auto sample : samples) {
+        if (!sample.empty()) {
+            sorted.push_back(sample);
+        }
+    }
+
+    std::ranges::sort(sorted, [](const auto lhs, const auto rhs) {
+        return lhs.size() != rhs.size()
+                   ? lhs.size() < rhs.size()
+                   : std::memcmp(lhs.data(), rhs.data(), lhs.size()) < 0;
+    });
+
+    std::vector<std::pair<std::span<const std::byte>, std::size_t>> ranks{};
+    for (const auto sample : sorted) {
+        if (!ranks.empty() && std::ranges::equal(ranks.back().first, sample)) {
+            ++ranks.back().second;
+        } else {
+            ranks.emplace_back(sample, 1);
+        }
+    }
+
+    std::ranges::stable_sort(ranks, [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second;
+    });
+
+    const auto limit{ std::min(max_size, compress_window) };
+    std::vector<std::span<const std::byte>> picked{};
+    std::size_t size{ 0 };
+    for (const auto& [sample, count] : ranks) {
+        if (size + sample.size() <= limit) {
+            picked.push_back(sample);
+            size += sample.size();
+        }
+    }
+
+    // The most frequent sample is placed last, closest to compressed data.
+    std::vector<std::byte> dictionary{};
+    dictionary.reserve(size);
+    for (auto i{ picked.rbegin() }; i != picked.rend(); ++i) {
+        dictionary.insert(dictionary.end(), i->begin(), i->end());
+    }
+
+    return dictionary;
+}
+
+
+Compressor::Compressor(const std::span<const std::byte> dictionary) :
+    dictionary_{ ClampDictionary(dictionary) } {
+    history_.reserve(2 * compress_window);
+    Reset();
+}
+
+std::size_t Compressor::Compress(const std::span<const std::byte> data,
+                                 std::vector<std::byte>& out) {
+    const auto begin{ out.size() };
+    for (auto rest{ data }; !rest.empty();) {
+        const auto chunk{ rest.first(std::min(rest.size(), compress_window)) };
+        CompressChunk(chunk, out);
+        rest = rest.subspan(chunk.size());
+    }
+
+    return out.size() - begin;
+}
+
+Packet Compressor::CompressPacket(const std::span<const std::byte> data) {
+    std::vector<std::byte> block{};
+    block.reserve(MaxCompressedSize(data.size()));
+    Compress(data, block);
+
+    Packet pkg{};
+    Header header{};
+    Seal({ reinterpret_cast<std::byte*>(&header), sizeof(header) },
+         std::array<std::span<const std::byte>, 1>{ block });
+    pkg.Write({ reinterpret_cast<const std::byte*>(&header), sizeof(header) });
+    pkg.Write(block);
+    return pkg;
+}
+
+void Compressor::Reset() {
+    history_.assign(dictionary_.begin(), dictionary_.end());
+    head_.fill(no_pos);
+    for (std::size_t pos{ 0 }; pos + min_match <= history_.size(); ++pos) {
+        Insert(pos);
+    }
+}
+
+std::size_t Compressor::Hash(const std::size_t pos) const noexcept {
+    assert(pos + min_match <= history_.size());
+
+    std::uint32_t val{ 0 };
+    std::memcpy(&val, history_.data() + pos, sizeof(val));
+    return (val * 2654435761U) >> (32 - hash_bits);
+}
+
+void Compressor::Insert(const std::size_t pos) noexcept {
+    head_[Hash(pos)] = static_cast<std::int32_t>(pos);
+}
+
+void Compressor::Slide(const std::size_t size) noexcept {
+    if (history_.size() + size <= 2 * compress_window) {
+        return;
+    }
+
+    const auto shift{ history_.size() - compress_window };
+    history_.erase(history_.begin(),
+                   history_.begin() + static_cast<std::ptrdiff_t>(shift));
+    for (auto& pos : head_) {
+        pos = pos < static_cast<std::int32_t>(shift)
+                  ? no_pos
+                  : pos - static_cast<std::int32_t>(shift);
+    }
+}
+
+void Compressor::CompressChunk(const std::span<const std::byte> data,
+                               std::vector<std::byte>& out) {
+    assert(data.size() <= compress_window);
+
+    Slide(data.size());
+    const auto begin{ history_.size() };
+    history_.insert(history_.end(), data.begin(), data.end());
+    const auto end{ history_.size() };
+
+    const auto emit_literals{ [this, &out](std::size_t from,
+                                           const std::size_t to) {
+        while (from != to) {
+            const auto count{ std::min(to - from, max_literals) };
+            out.push_back(static_cast<std::byte>(count - 1));
+            out.insert(out.end(),
+                       history_.begin() + static_cast<std::ptrdiff_t>(from),
+                       history_.begin()
+                           + static_cast<std::ptrdiff_t>(from + count));
+            from += count;
+        }
+    } };
+
+    auto literal{ begin };
+    auto pos{ begin };
+    while (pos + min_match <= end) {
+        const auto hash{ Hash(pos) };
+        const auto candidate{ head_[hash] };
+        head_[hash] = static_cast<std::int32_t>(pos);
+        if (candidate == no_pos
+            || pos - static_cast<std::size_t>(candidate) > compress_window
+            || std::memcmp(history_.data() + candidate, history_.data() + pos,
+                           min_match)
+                   != 0) {
+            ++pos;
+            continue;
+        }
+
+        const auto from{ static_cast<std::size_t>(candidate) };
+        auto len{ min_match };
+        while (len != max_match && pos + len != end
+               && history_[from + len] == history_[pos + len]) {
+            ++len;
+        }
+
+        emit_literals(literal, pos);
+        out.push_back(static_cast<std::byte>(0x80 | (len - min_match)));
+        std::array<std::byte, max_varint_size> distance{};
+        out.insert(out.end(), distance.begin(),
+                   distance.begin()
+                       + static_cast<std::ptrdiff_t>(
+                           WriteVarint(pos - from, distance)));
+
+        for (auto next{ pos + 1 }; next != pos + len && next + min_match <= end;
+             ++next) {
+            Insert(next);
+        }
+
+        pos += len;
+        literal = pos;
+    }
+
+    emit_literals(literal, end);
+}
+
+
+Decompressor::Decompressor(const std::span<const std::byte> dictionary) :
+    dictionary_{ ClampDictionary(dictionary) } {
+    Reset();
+}
+
+std::size_t Decompressor::Decompress(const std::span<const std::byte> block,
+                                     std::vector<std::byte>& out) {
+    // Only the window can be referred to by a new block.
+    if (history_.size() > compress_window) {
+        history_.erase(history_.begin(),
+                       history_.end()
+                           - static_cast<std::ptrdiff_t>(compress_window));
+    }
+
+    const auto begin{ history_.size() };
+    for (std::size_t i{ 0 }; i != block.size();) {
+        const auto control{ static_cast<std::uint8_t>(block[i++]) };
+        if (control < Compressor::max_literals) {
+            const std::size_t count{ control + 1U };
+            if (count > block.size() - i) {
+                throw std::invalid_argument{ "The literal run is truncated." };
+            }
+
+            const auto literals{ block.subspan(i, count) };
+            history_.insert(history_.end(), literals.begin(), literals.end());
+            i += count;
+            continue;
+        }
+
+        const auto distance{ ReadVarint(block.subspan(i)) };
+        if (!distance.has_value()) {
+            throw std::invalid_argument{ "The match is truncated." };
+        } else if (distance->first == 0 || distance->first > compress_window
+                   || distance->first > history_.size()) {
+            throw std::invalid_argument{ "The match distance is invalid." };
+        }
+
+        i += distance->second;
+        const std::size_t len{ (control & 0x7FU) + Compressor::min_match };
+        auto from{ history_.size() - static_cast<std::size_t>(distance->first) };
+        history_.reserve(history_.size() + len);
+
+        // A match can overlap the data it produces.
+        for (std::size_t k{ 0 }; k != len; ++k) {
+            const auto byte{ history_[from++] };
+            history_.push_back(byte);
+        }
+    }
+
+    out.insert(out.end(), history_.begin() + static_cast<std::ptrdiff_t>(begin),
+               history_.end());
+    return history_.size() - begin;
+}
+
+std::size_t Decompressor::DecompressPacket(
+    const std::span<const std::byte> packet, std::vector<std::byte>& out) {
+    Verify(packet);
+    return Decompress(packet.subspan(sizeof(Header)), out);
+}
+
+void Decompressor::Reset() {
+    history_.assign(dictionary_.begin(), dictionary_.end());
+}
+
+}  // namespace net
@@ -0,0 +1,395 @@
+#include "connector.h"
+
+#include "reactor.h"
+
+#ifndef _WIN32
+    #include <netdb.h>
+#endif  // _WIN32
+
+#include <algorithm>
+#include <coroutine>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+
+namespace net {
+
+namespace {
+
+/**
+ * @brief Racing connection attempts on an event loop.
+ *
+ * @details
+ * It is owned by the coroutine waiting for it.
+ * Reactor handlers refer to it directly and are removed when the race finishes,
+ * while tasks posted from other threads hold weak references.
+ */
+class Race final : public std::enable_shared_from_this<Race> {
+public:
+    Race(Reactor& reactor, std::vector<SockAddr> addrs,
+         const ConnectOptions& options) noexcept;
+
+    ~Race() noexcept;
+
+    Race(const Race&) = delete;
+
+    Race& operator=(const Race&) = delete;
+
+    //! Start the first attempt and the deadline.
+    void Start();
+
+    //! Check if the race has finished.
+    bool Done() const noexcept;
+
+    //! Set the coroutine resumed when the race finishes.
+    void SetWaiter(std::coroutine_handle<> handle) noexcept;
+
+    //! Cancel all pending attempts.
+    void Cancel();
+
+    /**
+     * @brief Take the connected socket.
+     *
+     * @exception std::system_error All attempts failed, the timeout expired or the race has been cancelled.
+     */
+    TcpSocket<SockAddr> Result();
+
+private:
+    //! Start the next attempt and schedule the one after it.
+    void StartNext();
+
+    //! Handle the completion of a pending attempt.
+    void OnReady(std::size_t idx);
+
+    void Win(TcpSocket<SockAddr> socket);
+
+    //! Finish the race and resume the waiting coroutine on the loop.
+    void Finish(std::error_code err = {});
+
+    //! Remove reactor handlers and close pending sockets.
+    void Cleanup() noexcept;
+
+    Reactor& reactor_;
+
+    std::vector<SockAddr> addrs_;
+
+    ConnectOptions options_;
+
+    //! The index of the next address to attempt.
+    std::size_t next_{ 0 };
+
+    //! Pending attempts keyed by their address indexes.
+    std::map<std::size_t, TcpSocket<SockAddr>> pending_{};
+
+    std::optional<Reactor::TimerId> attempt_timer_{};
+
+    std::optional<Reactor::TimerId> deadline_timer_{};
+
+    std::optional<TcpSocket<SockAddr>> winner_{};
+
+    //! The error of the latest failed attempt, or the reason the race finished.
+    std::error_code error_{};
+
+    bool done_{ false };
+
+    std::coroutine_handle<> waiter_{};
+};
+
+//! The awaiter waiting for a race to finish.
+struct RaceAwaiter {
+    bool await_ready() const noexcept {
+        return race.Done();
+    }
+
+    void await_suspend(const std::coroutine_handle<> handle) noexcept {
+        race.SetWaiter(handle);
+    }
+
+    void await_resume() const noexcept {}
+
+    Race& race;
+};
+
+//! Cancel a race on its loop from any thread.
+struct RaceCanceller {
+    void operator()() const noexcept {
+        try {
+            reactor->Post([race{ race }] {
+                if (const auto locked{ race.lock() }) {
+                    locked->Cancel();
+                }
+            });
+        } catch (...) {
+        }
+    }
+
+    Reactor* reactor;
+    std::weak_ptr<Race> race;
+};
+
+
+Race::Race(Reactor& reactor, std::vector<SockAddr> addrs,
+           const ConnectOptions& options) noexcept :
+    reactor_{ reactor }, addrs_{ std::move(addrs) }, options_{ options } {}
+
+Race::~Race() noexcept {
+    Cleanup();
+}
+
+void Race::Start() {
+    deadline_timer_ = reactor_.AddTimer(options_.timeout, [this] {
+        deadline_timer_.reset();
+        Finish(std::make_error_code(std::errc::timed_out));
+    });
+
+    StartNext();
+}
+
+bool Race::Done() const noexcept {
+    return done_;
+}
+
+void Race::SetWaiter(const std::coroutine_handle<> handle) noexcept {
+    waiter_ = handle;
+}
+
+void Race::Cancel() {
+    Finish(std::make_error_code(std::errc::operation_canceled));
+}
+
+TcpSocket<SockAddr> Race::Result() {
+    if (!winner_.has_value()) {
+        throw std::system_error{ error_ };
+    }
+
+    return std::move(winner_.value());
+}
+
+void Race::StartNext() {
+    if (attempt_timer_.has_value()) {
+        reactor_.CancelTimer(attempt_timer_.value());
+        attempt_timer_.reset();
+    }
+
+    while (next_ != addrs_.size()) {
+        const auto idx{ next_++ };
+        const auto& addr{ addrs_[idx] };
+        try {
+            TcpSocket<SockAddr> socket{ addr };
+            socket.SetNonBlocking(true);
+            if (connect(socket.ID(), addr.Raw(),
+                        static_cast<SockLen>(addr.Size()))
+                != socket_error) {
+                Win(std::move(socket));
+                return;
+            } else if (!LastSocketErrorWouldBlock()) {
+                ThrowLastSocketError();
+            }
+
+            reactor_.Watch(socket.ID(), Event::Write,
+                           [this, idx](Event) { OnReady(idx); });
+            pending_.emplace(idx, std::move(socket));
+        } catch (const std::system_error& err) {
+            // A failed attempt is skipped immediately.
+            error_ = err.code();
+            continue;
+        }
+
+        if (next_ != addrs_.size()) {
+            attempt_timer_
+                = reactor_.AddTimer(options_.attempt_delay, [this] {
+                      attempt_timer_.reset();
+                      StartNext();
+                  });
+        }
+
+        return;
+    }
+
+    if (pending_.empty()) {
+        Finish(error_);
+    }
+}
+
+void Race::OnReady(const std::size_t idx) {
+    const auto it{ pending_.find(idx) };
+    auto socket{ std::move(it->second) };
+    pending_.erase(it);
+    reactor_.Unwatch(socket.ID());
+
+    try {
+        if (const auto err{ TakeSocketError(socket.ID()) }; err != 0) {
+            throw std::system_error{ err, std::system_category() };
+        }
+
+        Win(std::move(socket));
+    } catch (const std::system_error& err) {
+        error_ = err.code();
+        if (pending_.empty()) {
+            StartNext();
+        }
+    }
+}
+
+void Race::Win(TcpSocket<SockAddr> socket) {
+    socket.SetNonBlocking(false);
+    winner_.emplace(std::move(socket));
+    Finish();
+}
+
+void Race::Finish(const std::error_code err) {
+    if (done_) {
+        return;
+    }
+
+    done_ = true;
+    if (err) {
+        error_ = err;
+    }
+
+    Cleanup();
+
+    // Resuming on the loop lets the coroutine destroy the race safely.
+    if (waiter_) {
+        reactor_.Post([race{ weak_from_this() }] {
+            if (const auto locked{ race.lock() }) {
+                std::exchange(locked->waiter_, {}).resume();
+            }
+        });
+    }
+}
+
+void Race::Cleanup() noexcept {
+    for (const auto timer : { &attempt_timer_, &deadline_timer_ }) {
+        if (timer->has_value()) {
+            reactor_.CancelTimer(timer->value());
+            timer->reset();
+        }
+    }
+
+    for (const auto& [idx, socket] : pending_) {
+        reactor_.Unwatch(socket.ID());
+    }
+
+    pending_.clear();
+}
+
+//! Interleave addresses by version, starting with the version of the first one.
+std::vector<SockAddr> Interleave(const std::vector<SockAddr>& addrs) {
+    std::vector<SockAddr> first{}, second{};
+    for (const auto& addr : addrs) {
+        (addr.Version() == addrs.front().Version() ? first : second)
+            .push_back(addr);
+    }
+
+    std::vector<SockAddr> mixed{};
+    mixed.reserve(addrs.size());
+    for (std::size_t i{ 0 }; i != std::max(first.size(), second.size());
+         ++i) {
+        for (const auto* family : { &first, &second }) {
+            if (i < family->size()) {
+                mixed.push_back((*family)[i]);
+            }
+        }
+    }
+
+    return mixed;
+}
+
+//! Connect on a private loop and stop it.
+Task<> ConnectAndStop(std::vector<SockAddr> addrs,
+                      const ConnectOptions options,
+                      std::optional<TcpSocket<SockAddr>>& socket) {
+    auto& executor{ Executor::Current() };
+    try {
+        socket.emplace(co_await AsyncConnectAny(std::move(addrs), options));
+    } catch (...) {
+        executor.Stop();
+        throw;
+    }
+
+    executor.Stop();
+}
+
+}  // namespace
+
+
+std::vector<SockAddr> Resolve(const std::string_view host,
+                              const std::uint16_t port) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    const std::string name{ host };
+    const auto service{ std::to_string(port) };
+    addrinfo* result{ nullptr };
+    if (const auto err{
+            getaddrinfo(name.c_str(), service.c_str(), &hints, &result) };
+        err != 0) {
+        throw std::runtime_error{ "Failed to resolve " + name + ": "
+                                  + gai_strerror(err) };
+    }
+
+    const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> guard{
+        result, freeaddrinfo
+    };
+
+    std::vector<SockAddr> addrs{};
+    for (auto info{ result }; info != nullptr; info = info->ai_next) {
+        if (info->ai_family == AF_INET || info->ai_family == AF_INET6) {
+            addrs.emplace_back(info->ai_addr, info->ai_addrlen);
+        }
+    }
+
+    if (addrs.empty()) {
+        throw std::runtime_error{ "Failed to resolve " + name
+                                  + ": No IP address." };
+    }
+
+    return Interleave(addrs);
+}
+
+Task<TcpSocket<SockAddr>> AsyncConnectAny(std::vector<SockAddr> addrs,
+                                          const ConnectOptions options,
+                                          const std::stop_token stop_token) {
+    if (addrs.empty()) {
+        throw std::invalid_argument{ "There is no address." };
+    }
+
+    auto& reactor{ Executor::Current().EventLoop() };
+    const auto race{ std::make_shared<Race>(reactor, std::move(addrs),
+                                            options) };
+    race->Start();
+
+    const std::stop_callback on_stop{ stop_token,
+                                      RaceCanceller{ &reactor, race } };
+    co_await RaceAwaiter{ *race };
+    co_return race->Result();
+}
+
+Task<TcpSocket<SockAddr>> AsyncConnectHost(Resolver& resolver,
+                                           const std::string host,
+                                           const std::uint16_t port,
+                                           const ConnectOptions options,
+                                           const std::stop_token stop_token) {
+    auto addrs{ co_await resolver.AsyncResolve(host, port, stop_token) };
+    co_return co_await AsyncConnectAny(std::move(addrs), options, stop_token);
+}
+
+TcpSocket<SockAddr> ConnectAny(std::vector<SockAddr> addrs,
+                               const ConnectOptions options) {
+    Reactor reactor{};
+    Executor executor{ reactor };
+    std::optional<TcpSocket<SockAddr>> socket{};
+    executor.Spawn(ConnectAndStop(std::move(addrs), options, socket));
+    executor.Run();
+    return std::move(socket.value());
+}
+
+}  // namespace net
@@ -0,0 +1,167 @@
+#include "crc32c.h"
+#include "byte_order.h"
+
+#include <array>
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) \
+    || defined(__x86_64__)
+#define CRC32C_X86
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CRC32C_TARGET
+#else
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+#endif
+#elif defined(__ARM_FEATURE_CRC32)
+#define CRC32C_ARM
+#include <arm_acle.h>
+#endif
+
+
+namespace net {
+
+namespace {
+
+//! The reversed Castagnoli polynomial.
+constexpr std::uint32_t polynomial{ 0x82F63B78 };
+
+//! Build tables of slicing-by-8, where each one advances the checksum by one more byte.
+constexpr std::array<std::array<std::uint32_t, 256>, 8> MakeTables() noexcept {
+    std::array<std::array<std::uint32_t, 256>, 8> tables{};
+    for (std::uint32_t i{ 0 }; i != tables[0].size(); ++i) {
+        auto crc{ i };
+        for (auto bit{ 0 }; bit != 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1) != 0 ? polynomial : 0);
+        }
+
+        tables[0][i] = crc;
+    }
+
+    for (std::size_t t{ 1 }; t != tables.size(); ++t) {
+        for (std::size_t i{ 0 }; i != tables[t].size(); ++i) {
+            const auto prev{ tables[t - 1][i] };
+            tables[t][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+        }
+    }
+
+    return tables;
+}
+
+constexpr auto tables{ MakeTables() };
+
+std::uint32_t SoftwareUpdate(std::span<const std::byte> data,
+                             std::uint32_t crc) noexcept {
+    while (data.size() >= 8) {
+        const auto low{ LoadLittle<std::uint32_t>(data.data()) ^ crc };
+        const auto high{ LoadLittle<std::uint32_t>(data.data() + 4) };
+        crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF]
+              ^ tables[5][(low >> 16) & 0xFF] ^ tables[4][low >> 24]
+              ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF]
+              ^ tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+        data = data.subspan(8);
+    }
+
+    for (const auto byte : data) {
+        crc = (crc >> 8)
+              ^ tables[0][(crc ^ static_cast<std::uint32_t>(byte)) & 0xFF];
+    }
+
+    return crc;
+}
+
+#if defined(CRC32C_X86)
+
+bool DetectHardware() noexcept {
+#ifdef _MSC_VER
+    std::array<int, 4> info{};
+    __cpuid(info.data(), 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+#endif
+}
+
+CRC32C_TARGET std::uint32_t HardwareUpdate(std::span<const std::byte> data,
+                                           std::uint32_t crc) noexcept {
+#if defined(_M_X64) || defined(__x86_64__)
+    std::uint64_t crc64{ crc };
+    while (data.size() >= sizeof(std::uint64_t)) {
+        std::uint64_t val{ 0 };
+        std::memcpy(&val, data.data(), sizeof(val));
+        crc64 = _mm_crc32_u64(crc64, val);
+        data = data.subspan(sizeof(val));
+    }
+
+    crc = static_cast<std::uint32_t>(crc64);
+#endif
+    while (data.size() >= sizeof(std::uint32_t)) {
+        std::uint32_t val{ 0 };
+        std::memcpy(&val, data.data(), sizeof(val));
+        crc = _mm_crc32_u32(crc, val);
+        data = data.subspan(sizeof(val));
+    }
+
+    for (const auto byte : data) {
+        crc = _mm_crc32_u8(crc, static_cast<std::uint8_t>(byte));
+    }
+
+    return crc;
+}
+
+#elif defined(CRC32C_ARM)
+
+bool DetectHardware() noexcept {
+    return true;
+}
+
+std::uint32_t HardwareUpdate(std::span<const std::byte> data,
+                             std::uint32_t crc) noexcept {
+    while (data.size() >= sizeof(std::uint64_t)) {
+        std::uint64_t val{ 0 };
+        std::memcpy(&val, data.data(), sizeof(val));
+        crc = __crc32cd(crc, val);
+        data = data.subspan(sizeof(val));
+    }
+
+    for (const auto byte : data) {
+        crc = __crc32cb(crc, static_cast<std::uint8_t>(byte));
+    }
+
+    return crc;
+}
+
+#else
+
+bool DetectHardware() noexcept {
+    return false;
+}
+
+std::uint32_t HardwareUpdate(const std::span<const std::byte> data,
+                             const std::uint32_t crc) noexcept {
+    return SoftwareUpdate(data, crc);
+}
+
+#endif
+
+//! Whether hardware instructions are available, which is detected once.
+const bool hardware{ DetectHardware() };
+
+}  // namespace
+
+
+std::uint32_t Crc32c(const std::span<const std::byte> data,
+                     const std::uint32_t crc) noexcept {
+    // The checksum is inverted before and after, as the standard requires.
+    const auto state{ ~crc };
+    return ~(hardware ? HardwareUpdate(data, state)
+                      : SoftwareUpdate(data, state));
+}
+
+bool HardwareCrc32c() noexcept {
+    return hardware;
+}
+
+}  // namespace net
@@ -1,33 +1,27 @@
 #include "ip_addr.h"
 
-#include "system/windows_error.h"
-
-#pragma comment(lib, "ws2_32.lib")
+#include <cstring>
+#include <stdexcept>
 
 
 namespace net {
 
 namespace {
 
-//! A socket library initializer.
-struct Initializer {
-    Initializer();
-    ~Initializer() noexcept;
-};
-
-const Initializer initializer_{};
-
-Initializer::Initializer() {
-    WSADATA wsa{};
-    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
-        sys::ThrowWsaLastError();
+/**
+ * @brief Convert a numeric IP address into its binary form.
+ *
+ * @exception std::invalid_argument The IP address is invalid.
+ * @exception std::system_error The operation failed.
+ */
+void ParseIp(const int version, const std::string_view ip, void* const dest) {
+    if (const auto ret{ inet_pton(version, ip.data(), dest) }; ret == 0) {
+        throw std::invalid_argument{ "The IP address is invalid." };
+    } else if (ret != 1) {
+        ThrowLastSocketError();
     }
 }
 
-Initializer::~Initializer() noexcept {
-    WSACleanup();
-}
-
 }  // namespace
 
 Ipv4Addr::Ipv4Addr(const sockaddr_in& addr) noexcept : addr_{ addr } {}
@@ -35,9 +29,7 @@ Ipv4Addr::Ipv4Addr(const sockaddr_in& addr) noexcept : addr_{ addr } {}
 Ipv4Addr::Ipv4Addr(const std::string_view ip, const std::uint16_t port) {
     addr_.sin_family = version;
     addr_.sin_port = htons(port);
-    if (inet_pton(version, ip.data(), &addr_.sin_addr) != 1) {
-        sys::ThrowWsaLastError();
-    }
+    ParseIp(version, ip, &addr_.sin_addr);
 }
 
 int Ipv4Addr::Version() const noexcept {
@@ -58,9 +50,7 @@ Ipv6Addr::Ipv6Addr(const sockaddr_in6& addr) noexcept : addr_{ addr } {}
 Ipv6Addr::Ipv6Addr(const std::string_view ip, const std::uint16_t port) {
     addr_.sin6_family = version;
     addr_.sin6_port = htons(port);
-    if (inet_pton(version, ip.data(), &addr_.sin6_addr) != 1) {
-        sys::ThrowWsaLastError();
-    }
+    ParseIp(version, ip, &addr_.sin6_addr);
 }
 
 int Ipv6Addr::Version() const noexcept {
@@ -75,4 +65,46 @@ const sockaddr* Ipv6Addr::Raw() const noexcept {
     return reinterpret_cast<const sockaddr*>(&addr_);
 }
 
+
+SockAddr::SockAddr(const sockaddr_storage& addr) noexcept : addr_{ addr } {}
+
+SockAddr::SockAddr(const Ipv4Addr& addr) noexcept {
+    std::memcpy(&addr_, addr.Raw(), addr.Size());
+}
+
+SockAddr::SockAddr(const Ipv6Addr& addr) noexcept {
+    std::memcpy(&addr_, addr.Raw(), addr.Size());
+}
+
+SockAddr::SockAddr(const sockaddr* const addr, const std::size_t size) {
+    if ((addr->sa_family != AF_INET && addr->sa_family != AF_INET6)
+        || size > sizeof(addr_)) {
+        throw std::invalid_argument{ "The address is neither IPv4 nor IPv6." };
+    }
+
+    std::memcpy(&addr_, addr, size);
+}
+
+SockAddr::SockAddr(const std::string_view ip, const std::uint16_t port) {
+    // Only IPv6 addresses contain colons.
+    if (ip.find(':') != std::string_view::npos) {
+        *this = SockAddr{ Ipv6Addr{ ip, port } };
+    } else {
+        *this = SockAddr{ Ipv4Addr{ ip, port } };
+    }
+}
+
+int SockAddr::Version() const noexcept {
+    return addr_.ss_family;
+}
+
+std::size_t SockAddr::Size() const noexcept {
+    return addr_.ss_family == AF_INET6 ? sizeof(sockaddr_in6)
+                                       : sizeof(sockaddr_in);
+}
+
+const sockaddr* SockAddr::Raw() const noexcept {
+    return reinterpret_cast<const sockaddr*>(&addr_);
+}
+
 }  // namespace net
\ No newline at end of file
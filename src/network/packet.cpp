@@ -1,19 +1,155 @@
 #include "packet.h"
+#include "crc32c.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <utility>
 
 
 namespace net {
 
-std::size_t Packet::Write(const std::span<const std::byte> data) noexcept {
-    buffer_.reserve(buffer_.size() + data.size());
-    for (const auto byte : data) {
-        buffer_.push_back(byte);
+namespace {
+
+//! Check if a header has a flag.
+bool HasFlag(const Header& header, const HeaderFlag flag) noexcept {
+    return (header.flags & static_cast<std::uint8_t>(flag)) != 0;
+}
+
+}  // namespace
+
+
+void Seal(const std::span<std::byte> head,
+          const std::span<const std::span<const std::byte>> payload) {
+    assert(head.size_bytes() >= sizeof(Header));
+
+    Header header{};
+    std::memcpy(&header, head.data(), sizeof(header));
+
+    const auto body{ head.subspan(sizeof(Header)) };
+    auto size{ body.size_bytes() };
+    for (const auto buffer : payload) {
+        size += buffer.size_bytes();
+    }
+
+    if (size > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error{ "The packet is too large." };
+    }
+
+    header.size = static_cast<std::uint32_t>(size);
+    if (HasFlag(header, HeaderFlag::Checksum)) {
+        auto crc{ Crc32c(body) };
+        for (const auto buffer : payload) {
+            crc = Crc32c(buffer, crc);
+        }
+
+        header.checksum = crc;
+    }
+
+    StoreHeader(header, head);
+}
+
+void Verify(const std::span<const std::byte> packet) {
+    if (packet.size_bytes() < sizeof(Header)) {
+        throw std::invalid_argument{ "The packet is too small." };
+    }
+
+    const auto header{ LoadHeader(packet) };
+    if (header.version != header_version) {
+        throw std::invalid_argument{ "The header version is unsupported." };
+    }
+
+    const auto body{ packet.subspan(sizeof(Header)) };
+    if (header.size != body.size_bytes()) {
+        throw std::invalid_argument{ "The packet size is mismatched." };
+    } else if (HasFlag(header, HeaderFlag::Checksum)
+               && Crc32c(body) != header.checksum) {
+        throw std::invalid_argument{ "The checksum is mismatched." };
+    }
+}
+
+
+Packet::Packet(const Packet& that) {
+    Write(that.Read());
+}
+
+Packet::Packet(Packet&& that) noexcept :
+    block_{ std::exchange(that.block_, {}) },
+    size_{ std::exchange(that.size_, 0) } {
+    if (block_.empty()) {
+        std::memcpy(inline_.data(), that.inline_.data(), size_);
+    }
+}
+
+Packet& Packet::operator=(const Packet& that) {
+    if (this != &that) {
+        size_ = 0;
+        Write(that.Read());
+    }
+
+    return *this;
+}
+
+Packet& Packet::operator=(Packet&& that) noexcept {
+    if (this != &that) {
+        ReleaseBlock();
+        block_ = std::exchange(that.block_, {});
+        size_ = std::exchange(that.size_, 0);
+        if (block_.empty()) {
+            std::memcpy(inline_.data(), that.inline_.data(), size_);
+        }
+    }
+
+    return *this;
+}
+
+Packet::~Packet() noexcept {
+    ReleaseBlock();
+}
+
+std::size_t Packet::Write(const std::span<const std::byte> data) {
+    if (!data.empty()) {
+        std::memcpy(Extend(data.size_bytes()).data(), data.data(),
+                    data.size_bytes());
     }
 
-    return buffer_.size();
+    return size_;
+}
+
+std::span<const std::byte> Packet::Read() const noexcept {
+    return Storage().first(size_);
+}
+
+std::span<std::byte> Packet::Storage() noexcept {
+    return block_.empty() ? std::span<std::byte>{ inline_ } : block_;
+}
+
+std::span<const std::byte> Packet::Storage() const noexcept {
+    return block_.empty() ? std::span<const std::byte>{ inline_ } : block_;
+}
+
+void Packet::Reserve(const std::size_t capacity) {
+    if (capacity <= Storage().size()) {
+        return;
+    }
+
+    // The capacity grows geometrically, so appending stays amortized constant.
+    const auto block{ BufferPool::Shared().Acquire(
+        std::max(capacity, Storage().size() * 2)) };
+    std::memcpy(block.data(), Storage().data(), size_);
+    ReleaseBlock();
+    block_ = block;
+}
+
+std::span<std::byte> Packet::Extend(const std::size_t size) {
+    Reserve(size_ + size);
+    const auto offset{ std::exchange(size_, size_ + size) };
+    return Storage().subspan(offset, size);
 }
 
-std::span<const std::byte> Packet::Read() noexcept {
-    return buffer_;
+void Packet::ReleaseBlock() noexcept {
+    BufferPool::Shared().Release(std::exchange(block_, {}));
 }
 
-}
\ No newline at end of file
+}  // namespace net
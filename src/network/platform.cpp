@@ -0,0 +1,113 @@
+#include "platform.h"
+
+#ifdef _WIN32
+    #include "system/windows_error.h"
+
+    #pragma comment(lib, "ws2_32.lib")
+#else
+    #include <fcntl.h>
+
+    #include <cerrno>
+    #include <system_error>
+#endif  // _WIN32
+
+
+namespace net {
+
+namespace {
+
+#ifdef _WIN32
+//! A socket library initializer.
+struct Initializer {
+    Initializer();
+    ~Initializer() noexcept;
+};
+
+const Initializer initializer_{};
+
+Initializer::Initializer() {
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        sys::ThrowWsaLastError();
+    }
+}
+
+Initializer::~Initializer() noexcept {
+    WSACleanup();
+}
+#endif  // _WIN32
+
+}  // namespace
+
+void CloseSocket(const SocketId id) noexcept {
+#ifdef _WIN32
+    closesocket(id);
+#else
+    close(id);
+#endif  // _WIN32
+}
+
+[[noreturn]] void ThrowLastSocketError() {
+#ifdef _WIN32
+    sys::ThrowWsaLastError();
+#else
+    throw std::system_error{ errno, std::system_category() };
+#endif  // _WIN32
+}
+
+void SetNonBlocking(const SocketId id, const bool enable) {
+#ifdef _WIN32
+    u_long mode{ enable ? 1UL : 0UL };
+    if (ioctlsocket(id, FIONBIO, &mode) == socket_error) {
+        ThrowLastSocketError();
+    }
+#else
+    const auto flags{ fcntl(id, F_GETFL) };
+    if (flags == -1
+        || fcntl(id, F_SETFL,
+                 enable ? flags | O_NONBLOCK : flags & ~O_NONBLOCK)
+               == -1) {
+        ThrowLastSocketError();
+    }
+#endif  // _WIN32
+}
+
+bool LastSocketErrorWouldBlock() noexcept {
+#ifdef _WIN32
+    const auto err{ WSAGetLastError() };
+    return err == WSAEWOULDBLOCK || err == WSAEINPROGRESS;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINPROGRESS;
+#endif  // _WIN32
+}
+
+int TakeSocketError(const SocketId id) {
+    int err{ 0 };
+    auto size{ static_cast<SockLen>(sizeof(err)) };
+    if (getsockopt(id, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&err),
+                   &size)
+        == socket_error) {
+        ThrowLastSocketError();
+    }
+
+    return err;
+}
+
+SocketId AcceptSocket(const SocketId id) noexcept {
+#ifdef __linux__
+    return accept4(id, nullptr, nullptr, SOCK_CLOEXEC);
+#else
+    return accept(id, nullptr, nullptr);
+#endif  // __linux__
+}
+
+bool LastSocketErrorAborted() noexcept {
+#ifdef _WIN32
+    const auto err{ WSAGetLastError() };
+    return err == WSAECONNRESET || err == WSAEINTR;
+#else
+    return errno == ECONNABORTED || errno == EINTR || errno == EPROTO;
+#endif  // _WIN32
+}
+
+}  // namespace net
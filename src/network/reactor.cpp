@@ -0,0 +1,411 @@
+#define NOMINMAX
+
+#include "reactor.h"
+
+#ifndef _WIN32
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+#endif  // _WIN32
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cerrno>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+
+namespace net {
+
+namespace {
+
+//! Convert a waiting time into milliseconds, rounding up to avoid busy waiting.
+int ToMilliseconds(const std::optional<Reactor::Clock::duration> timeout) {
+    if (!timeout.has_value()) {
+        return -1;
+    }
+
+    const auto ms{ std::chrono::ceil<std::chrono::milliseconds>(
+        std::max(timeout.value(), Reactor::Clock::duration::zero())) };
+    return static_cast<int>(std::min<std::chrono::milliseconds::rep>(
+        ms.count(), std::numeric_limits<int>::max()));
+}
+
+#ifdef _WIN32
+SHORT ToPollEvents(const Event events) noexcept {
+    SHORT flags{ 0 };
+    if (HasEvent(events, Event::Read)) {
+        flags |= POLLRDNORM;
+    }
+
+    if (HasEvent(events, Event::Write)) {
+        flags |= POLLWRNORM;
+    }
+
+    return flags;
+}
+
+Event FromPollEvents(const SHORT flags) noexcept {
+    auto events{ Event::None };
+    if ((flags & (POLLRDNORM | POLLRDBAND)) != 0) {
+        events = events | Event::Read;
+    }
+
+    if ((flags & POLLWRNORM) != 0) {
+        events = events | Event::Write;
+    }
+
+    if ((flags & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
+        events = events | Event::Error;
+    }
+
+    return events;
+}
+#else
+std::uint32_t ToEpollEvents(const Event events) noexcept {
+    std::uint32_t flags{ 0 };
+    if (HasEvent(events, Event::Read)) {
+        flags |= EPOLLIN;
+    }
+
+    if (HasEvent(events, Event::Write)) {
+        flags |= EPOLLOUT;
+    }
+
+    return flags;
+}
+
+Event FromEpollEvents(const std::uint32_t flags) noexcept {
+    auto events{ Event::None };
+    if ((flags & EPOLLIN) != 0) {
+        events = events | Event::Read;
+    }
+
+    if ((flags & EPOLLOUT) != 0) {
+        events = events | Event::Write;
+    }
+
+    if ((flags & (EPOLLERR | EPOLLHUP)) != 0) {
+        events = events | Event::Error;
+    }
+
+    return events;
+}
+#endif  // _WIN32
+
+}  // namespace
+
+
+#ifdef _WIN32
+Reactor::Reactor() {
+    wakeup_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (wakeup_ == invalid_socket) {
+        ThrowLastSocketError();
+    }
+
+    try {
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        SockLen size{ sizeof(addr) };
+        if (bind(wakeup_, reinterpret_cast<const sockaddr*>(&addr), size)
+                == socket_error
+            || getsockname(wakeup_, reinterpret_cast<sockaddr*>(&addr), &size)
+                   == socket_error
+            || connect(wakeup_, reinterpret_cast<const sockaddr*>(&addr), size)
+                   == socket_error) {
+            ThrowLastSocketError();
+        }
+
+        u_long non_blocking{ 1 };
+        if (ioctlsocket(wakeup_, FIONBIO, &non_blocking) == socket_error) {
+            ThrowLastSocketError();
+        }
+    } catch (...) {
+        CloseSocket(wakeup_);
+        throw;
+    }
+}
+
+Reactor::~Reactor() noexcept {
+    CloseSocket(wakeup_);
+}
+#else
+Reactor::Reactor() : epoll_{ epoll_create1(EPOLL_CLOEXEC) } {
+    if (epoll_ == -1) {
+        ThrowLastSocketError();
+    }
+
+    wakeup_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeup_ == -1) {
+        close(epoll_);
+        ThrowLastSocketError();
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wakeup_;
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, wakeup_, &event) == -1) {
+        close(wakeup_);
+        close(epoll_);
+        ThrowLastSocketError();
+    }
+}
+
+Reactor::~Reactor() noexcept {
+    close(wakeup_);
+    close(epoll_);
+}
+#endif  // _WIN32
+
+
+void Reactor::Watch(const SocketId id, const Event events, Handler handler) {
+    if (watchers_.contains(id)) {
+        throw std::invalid_argument{ "The socket has been watched." };
+    }
+
+#ifndef _WIN32
+    epoll_event event{};
+    event.events = ToEpollEvents(events);
+    event.data.fd = id;
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, id, &event) == -1) {
+        ThrowLastSocketError();
+    }
+#endif  // _WIN32
+
+    watchers_.emplace(id, Watcher{ events, std::move(handler) });
+}
+
+void Reactor::Modify(const SocketId id, const Event events) {
+    const auto it{ watchers_.find(id) };
+    if (it == watchers_.end()) {
+        throw std::invalid_argument{ "The socket is not watched." };
+    }
+
+#ifndef _WIN32
+    epoll_event event{};
+    event.events = ToEpollEvents(events);
+    event.data.fd = id;
+    if (epoll_ctl(epoll_, EPOLL_CTL_MOD, id, &event) == -1) {
+        ThrowLastSocketError();
+    }
+#endif  // _WIN32
+
+    it->second.events = events;
+}
+
+void Reactor::Unwatch(const SocketId id) noexcept {
+    if (watchers_.erase(id) == 0) {
+        return;
+    }
+
+#ifndef _WIN32
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, id, nullptr);
+#endif  // _WIN32
+}
+
+
+Reactor::TimerId Reactor::AddTimer(const Clock::duration delay, Task task,
+                                   const Clock::duration period) {
+    const auto id{ ++next_timer_id_ };
+    const auto deadline{ Clock::now() + delay };
+    timers_.emplace(std::pair{ deadline, id },
+                    Timer{ period, std::move(task) });
+    timer_deadlines_.emplace(id, deadline);
+    return id;
+}
+
+void Reactor::CancelTimer(const TimerId id) noexcept {
+    if (const auto it{ timer_deadlines_.find(id) };
+        it != timer_deadlines_.end()) {
+        timers_.erase({ it->second, id });
+        timer_deadlines_.erase(it);
+    }
+}
+
+
+void Reactor::Post(Task task) {
+    {
+        const std::lock_guard lock{ tasks_mtx_ };
+        tasks_.push_back(std::move(task));
+    }
+
+    Wakeup();
+}
+
+
+void Reactor::Run() {
+    while (!Stopped()) {
+        RunOnce(std::nullopt);
+    }
+}
+
+std::size_t Reactor::RunOnce(const std::optional<Clock::duration> timeout) {
+    if (Stopped()) {
+        return 0;
+    }
+
+    std::size_t count{ Poll(NextTimeout(timeout)) };
+    count += RunTasks();
+    count += RunTimers();
+    return count;
+}
+
+
+void Reactor::Stop() noexcept {
+    stopped_ = true;
+    Wakeup();
+}
+
+bool Reactor::Stopped() const noexcept {
+    return stopped_;
+}
+
+
+#ifdef _WIN32
+void Reactor::Wakeup() noexcept {
+    constexpr char signal{ 0 };
+    send(wakeup_, &signal, sizeof(signal), 0);
+}
+
+void Reactor::DrainWakeup() noexcept {
+    char signals[max_events]{};
+    while (recv(wakeup_, signals, sizeof(signals), 0) > 0) {
+    }
+}
+
+std::size_t Reactor::Poll(const std::optional<Clock::duration> timeout) {
+    std::vector<WSAPOLLFD> fds{};
+    fds.reserve(watchers_.size() + 1);
+    fds.push_back({ .fd{ wakeup_ }, .events{ POLLRDNORM } });
+    for (const auto& [id, watcher] : watchers_) {
+        fds.push_back({ .fd{ id }, .events{ ToPollEvents(watcher.events) } });
+    }
+
+    if (WSAPoll(fds.data(), static_cast<ULONG>(fds.size()),
+                ToMilliseconds(timeout))
+        == socket_error) {
+        ThrowLastSocketError();
+    }
+
+    std::size_t count{ 0 };
+    for (const auto& fd : fds) {
+        if (fd.revents == 0) {
+            continue;
+        } else if (fd.fd == wakeup_) {
+            DrainWakeup();
+        } else {
+            count += Dispatch(fd.fd, FromPollEvents(fd.revents));
+        }
+    }
+
+    return count;
+}
+#else
+void Reactor::Wakeup() noexcept {
+    const eventfd_t signal{ 1 };
+    [[maybe_unused]] const auto ret{ write(wakeup_, &signal, sizeof(signal)) };
+}
+
+void Reactor::DrainWakeup() noexcept {
+    eventfd_t signals{ 0 };
+    [[maybe_unused]] const auto ret{ read(wakeup_, &signals, sizeof(signals)) };
+}
+
+std::size_t Reactor::Poll(const std::optional<Clock::duration> timeout) {
+    std::array<epoll_event, max_events> events{};
+    const auto ready{ epoll_wait(epoll_, events.data(),
+                                 static_cast<int>(events.size()),
+                                 ToMilliseconds(timeout)) };
+    if (ready == -1) {
+        if (errno == EINTR) {
+            return 0;
+        }
+
+        ThrowLastSocketError();
+    }
+
+    std::size_t count{ 0 };
+    for (const auto& event : std::span{ events.data(),
+                                        static_cast<std::size_t>(ready) }) {
+        if (event.data.fd == wakeup_) {
+            DrainWakeup();
+        } else {
+            count += Dispatch(event.data.fd, FromEpollEvents(event.events));
+        }
+    }
+
+    return count;
+}
+#endif  // _WIN32
+
+
+std::size_t Reactor::Dispatch(const SocketId id, const Event events) {
+    const auto it{ watchers_.find(id) };
+    if (it == watchers_.end()) {
+        return 0;
+    }
+
+    // The handler may unwatch its own socket and destroy the function object.
+    const auto handler{ it->second.handler };
+    assert(handler);
+    handler(events);
+    return 1;
+}
+
+std::size_t Reactor::RunTasks() {
+    std::vector<Task> tasks{};
+    {
+        const std::lock_guard lock{ tasks_mtx_ };
+        tasks.swap(tasks_);
+    }
+
+    for (const auto& task : tasks) {
+        task();
+    }
+
+    return tasks.size();
+}
+
+std::size_t Reactor::RunTimers() {
+    std::size_t count{ 0 };
+    const auto now{ Clock::now() };
+    while (!timers_.empty() && timers_.begin()->first.first <= now
+           && !Stopped()) {
+        auto node{ timers_.extract(timers_.begin()) };
+        const auto id{ node.key().second };
+        auto& timer{ node.mapped() };
+        timer_deadlines_.erase(id);
+
+        if (timer.period > Clock::duration::zero()) {
+            // Re-arm before running, so the task can cancel its own timer.
+            const auto task{ timer.task };
+            // A late timer skips missed periods instead of firing repeatedly.
+            const auto deadline{ node.key().first + timer.period };
+            node.key() = { deadline <= now ? now + timer.period : deadline,
+                           id };
+            timer_deadlines_.emplace(id, node.key().first);
+            timers_.insert(std::move(node));
+            task();
+        } else {
+            timer.task();
+        }
+
+        ++count;
+    }
+
+    return count;
+}
+
+std::optional<Reactor::Clock::duration> Reactor::NextTimeout(
+    const std::optional<Clock::duration> timeout) const noexcept {
+    if (timers_.empty()) {
+        return timeout;
+    }
+
+    const auto next{ timers_.begin()->first.first - Clock::now() };
+    return timeout.has_value() ? std::min(timeout.value(), next) : next;
+}
+
+}  // namespace net
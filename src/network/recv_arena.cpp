@@ -0,0 +1,147 @@
+#include "recv_arena.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+
+namespace net {
+
+RecvArena::Frame::Frame(RecvArena& arena,
+                        const std::span<std::byte> data) noexcept :
+    arena_{ &arena }, data_{ data } {}
+
+RecvArena::Frame::Frame(Frame&& that) noexcept :
+    arena_{ std::exchange(that.arena_, nullptr) },
+    data_{ std::exchange(that.data_, {}) } {}
+
+RecvArena::Frame& RecvArena::Frame::operator=(Frame&& that) noexcept {
+    if (this != &that) {
+        Release();
+        arena_ = std::exchange(that.arena_, nullptr);
+        data_ = std::exchange(that.data_, {});
+    }
+
+    return *this;
+}
+
+RecvArena::Frame::~Frame() noexcept {
+    Release();
+}
+
+std::span<std::byte> RecvArena::Frame::Data() const noexcept {
+    return data_;
+}
+
+std::span<const std::byte> RecvArena::Frame::Read() const noexcept {
+    return data_;
+}
+
+void RecvArena::Frame::Release() noexcept {
+    if (arena_ != nullptr) {
+        std::exchange(arena_, nullptr)->Release(std::exchange(data_, {}));
+    }
+}
+
+
+RecvArena::RecvArena(const std::size_t budget,
+                     const std::size_t max_frame_size) :
+    budget_{ budget / sizeof(Slot) * sizeof(Slot) },
+    max_frame_size_{ max_frame_size } {
+    if (max_frame_size_ < sizeof(Header)
+        || max_frame_size_ > std::numeric_limits<std::uint32_t>::max()
+                                 - 2 * sizeof(Slot)) {
+        throw std::invalid_argument{ "The maximum frame size is invalid." };
+    } else if (budget_ < SlotSize(max_frame_size_)) {
+        throw std::invalid_argument{ "The budget is smaller than a frame." };
+    }
+
+    buffer_ = std::make_unique_for_overwrite<std::byte[]>(budget_);
+}
+
+RecvArena::Frame RecvArena::Allocate(const std::size_t size) {
+    if (size > max_frame_size_) {
+        throw std::runtime_error{ "The packet is too large." };
+    }
+
+    if (used_ == 0) {
+        head_ = 0;
+        tail_ = 0;
+    }
+
+    // The ring wraps when the space after the head is too small,
+    // and the rest of the buffer is skipped by a released slot.
+    const auto slot_size{ SlotSize(size) };
+    const auto wrapped{ used_ != 0 && head_ <= tail_ };
+    if (!wrapped && budget_ - head_ < slot_size) {
+        if (tail_ < slot_size) {
+            throw std::runtime_error{ "The receive budget is used up." };
+        }
+
+        const auto skipped{ budget_ - head_ };
+        if (skipped != 0) {
+            Mark(head_, { static_cast<std::uint32_t>(skipped), 1 });
+            used_ += skipped;
+        }
+
+        head_ = 0;
+    } else if (wrapped && tail_ - head_ < slot_size) {
+        throw std::runtime_error{ "The receive budget is used up." };
+    }
+
+    Mark(head_, { static_cast<std::uint32_t>(slot_size), 0 });
+    const std::span data{ buffer_.get() + head_ + sizeof(Slot), size };
+    head_ += slot_size;
+    used_ += slot_size;
+    return { *this, data };
+}
+
+std::size_t RecvArena::Budget() const noexcept {
+    return budget_;
+}
+
+std::size_t RecvArena::MaxFrameSize() const noexcept {
+    return max_frame_size_;
+}
+
+std::size_t RecvArena::InUse() const noexcept {
+    return used_;
+}
+
+std::size_t RecvArena::SlotSize(const std::size_t frame_size) noexcept {
+    // Slots are rounded up to the record size, so frames stay aligned for headers.
+    return (sizeof(Slot) + frame_size + sizeof(Slot) - 1) / sizeof(Slot)
+           * sizeof(Slot);
+}
+
+void RecvArena::Release(const std::span<std::byte> data) noexcept {
+    const auto offset{ static_cast<std::size_t>(data.data() - buffer_.get())
+                       - sizeof(Slot) };
+    assert(offset < budget_);
+
+    Slot slot{};
+    std::memcpy(&slot, buffer_.get() + offset, sizeof(slot));
+    slot.released = 1;
+    Mark(offset, slot);
+
+    while (used_ != 0) {
+        std::memcpy(&slot, buffer_.get() + tail_, sizeof(slot));
+        if (slot.released == 0) {
+            break;
+        }
+
+        used_ -= slot.size;
+        tail_ += slot.size;
+        if (tail_ == budget_) {
+            tail_ = 0;
+        }
+    }
+}
+
+void RecvArena::Mark(const std::size_t offset, const Slot& slot) noexcept {
+    std::memcpy(buffer_.get() + offset, &slot, sizeof(slot));
+}
+
+}  // namespace net
@@ -0,0 +1,253 @@
+#include "reliable.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+
+namespace net {
+
+namespace {
+
+//! Kinds of datagrams.
+enum class Kind : std::uint8_t {
+    //! A standalone acknowledgement.
+    Ack = 0,
+
+    Unordered = static_cast<std::uint8_t>(Delivery::Unordered),
+
+    Ordered = static_cast<std::uint8_t>(Delivery::Ordered)
+};
+
+//! The header of a datagram.
+struct DatagramHeader {
+    Kind kind;
+    std::uint8_t reserved[3];
+
+    //! The sequence number of the message.
+    std::uint32_t seq;
+
+    //! All sequence numbers below it have been received.
+    std::uint32_t ack;
+
+    //! Bit @p i means that sequence number <tt>ack + 1 + i</tt> has been received.
+    std::uint32_t ack_bits;
+};
+
+static_assert(sizeof(DatagramHeader) == 16);
+
+}  // namespace
+
+
+ReliableChannel::ReliableChannel(Transmit transmit, Deliver deliver,
+                                 const ReliableOptions& options) :
+    transmit_{ std::move(transmit) },
+    deliver_{ std::move(deliver) },
+    options_{ options },
+    next_seq_{ options.initial_seq },
+    next_expected_{ options.initial_seq },
+    loss_rng_{ options.loss_seed } {
+    if (!transmit_ || !deliver_) {
+        throw std::invalid_argument{ "The handlers are empty." };
+    }
+
+    if (options_.max_transmissions == 0
+        || options_.resend_timeout <= Clock::duration::zero()
+        || options_.loss_rate < 0 || options_.loss_rate >= 1) {
+        throw std::invalid_argument{ "The options are invalid." };
+    }
+
+    datagram_.reserve(sizeof(DatagramHeader) + max_msg_size);
+}
+
+void ReliableChannel::Send(const std::span<const std::byte> msg,
+                           const Delivery delivery,
+                           const Clock::time_point now) {
+    if (msg.size_bytes() > max_msg_size) {
+        throw std::invalid_argument{ "The message is too large." };
+    }
+
+    Pending pending{ .delivery{ delivery },
+                     .msg{ msg.begin(), msg.end() },
+                     .deadline{ now },
+                     .transmissions{ 0 } };
+    const auto seq{ next_seq_++ };
+    TransmitMsg(seq, unacked_.emplace(seq, std::move(pending)).first->second,
+                now);
+}
+
+bool ReliableChannel::Receive(const std::span<const std::byte> datagram) {
+    DatagramHeader header{};
+    if (datagram.size_bytes() < sizeof(header)) {
+        return false;
+    }
+
+    std::memcpy(&header, datagram.data(), sizeof(header));
+    if (header.kind != Kind::Ack && header.kind != Kind::Unordered
+        && header.kind != Kind::Ordered) {
+        return false;
+    }
+
+    Acknowledge(header.ack, header.ack_bits);
+    if (header.kind == Kind::Ack) {
+        return true;
+    }
+
+    // Even a duplicate is acknowledged, because the previous acknowledgement may be lost.
+    ack_pending_ = true;
+    if (!Record(header.seq)) {
+        return true;
+    }
+
+    // An ordered message waits until all earlier messages have been received.
+    // Unordered ones are delivered on arrival, so none of them is overtaken.
+    const auto msg{ datagram.subspan(sizeof(header)) };
+    if (header.kind == Kind::Ordered) {
+        held_.emplace(header.seq,
+                      std::vector<std::byte>{ msg.begin(), msg.end() });
+    } else {
+        ++stats_.delivered;
+        deliver_(msg);
+    }
+
+    DeliverHeld();
+    return true;
+}
+
+void ReliableChannel::Poll(const Clock::time_point now) {
+    for (auto& [seq, pending] : unacked_) {
+        if (pending.deadline > now) {
+            continue;
+        } else if (pending.transmissions >= options_.max_transmissions) {
+            throw std::runtime_error{
+                "The peer has not acknowledged a message in time."
+            };
+        }
+
+        ++stats_.resent;
+        TransmitMsg(seq, pending, now);
+    }
+
+    if (ack_pending_) {
+        DatagramHeader header{ .kind{ Kind::Ack },
+                               .reserved{},
+                               .seq{ 0 },
+                               .ack{ next_expected_ },
+                               .ack_bits{ AckBits() } };
+        ack_pending_ = false;
+        Output({ reinterpret_cast<const std::byte*>(&header), sizeof(header) });
+    }
+}
+
+std::optional<ReliableChannel::Clock::time_point>
+ReliableChannel::NextDeadline() const noexcept {
+    if (ack_pending_) {
+        return Clock::time_point::min();
+    }
+
+    std::optional<Clock::time_point> deadline{};
+    for (const auto& [seq, pending] : unacked_) {
+        if (!deadline.has_value() || pending.deadline < deadline.value()) {
+            deadline = pending.deadline;
+        }
+    }
+
+    return deadline;
+}
+
+std::size_t ReliableChannel::Unacknowledged() const noexcept {
+    return unacked_.size();
+}
+
+const ReliableStats& ReliableChannel::Stats() const noexcept {
+    return stats_;
+}
+
+
+void ReliableChannel::TransmitMsg(const std::uint32_t seq, Pending& pending,
+                                  const Clock::time_point now) {
+    const DatagramHeader header{ .kind{ static_cast<Kind>(pending.delivery) },
+                                 .reserved{},
+                                 .seq{ seq },
+                                 .ack{ next_expected_ },
+                                 .ack_bits{ AckBits() } };
+
+    datagram_.resize(sizeof(header) + pending.msg.size());
+    std::memcpy(datagram_.data(), &header, sizeof(header));
+    std::ranges::copy(pending.msg, datagram_.begin() + sizeof(header));
+
+    // The acknowledgement is piggybacked on the message.
+    ack_pending_ = false;
+    pending.deadline = now + options_.resend_timeout;
+    ++pending.transmissions;
+    Output(datagram_);
+}
+
+void ReliableChannel::Output(const std::span<const std::byte> datagram) {
+    if (options_.loss_rate > 0 && loss_dist_(loss_rng_) < options_.loss_rate) {
+        ++stats_.dropped;
+        return;
+    }
+
+    ++stats_.sent;
+    transmit_(datagram);
+}
+
+void ReliableChannel::Acknowledge(const std::uint32_t ack,
+                                  const std::uint32_t ack_bits) {
+    unacked_.erase(unacked_.begin(), unacked_.lower_bound(ack));
+    for (std::uint32_t i{ 0 }; i != 32; ++i) {
+        if ((ack_bits & (1U << i)) != 0) {
+            unacked_.erase(ack + 1 + i);
+        }
+    }
+}
+
+std::uint32_t ReliableChannel::AckBits() const noexcept {
+    std::uint32_t bits{ 0 };
+    for (const auto seq : early_) {
+        const auto offset{ seq - next_expected_ - 1 };
+        if (offset >= 32) {
+            break;
+        }
+
+        bits |= 1U << offset;
+    }
+
+    return bits;
+}
+
+bool ReliableChannel::Record(const std::uint32_t seq) {
+    if (SeqBefore(seq, next_expected_) || early_.contains(seq)) {
+        ++stats_.duplicates;
+        return false;
+    } else if (seq - next_expected_ >= max_seq_window) {
+        // It will be resent after the gap has been filled.
+        return false;
+    }
+
+    if (seq != next_expected_) {
+        early_.insert(seq);
+        return true;
+    }
+
+    ++next_expected_;
+    while (!early_.empty() && *early_.begin() == next_expected_) {
+        early_.erase(early_.begin());
+        ++next_expected_;
+    }
+
+    return true;
+}
+
+void ReliableChannel::DeliverHeld() {
+    while (!held_.empty() && SeqBefore(held_.begin()->first, next_expected_)) {
+        const auto held{ std::move(held_.begin()->second) };
+        held_.erase(held_.begin());
+        ++stats_.delivered;
+        deliver_(held);
+    }
+}
+
+}  // namespace net
@@ -0,0 +1,295 @@
+#include "resolver.h"
+#include "connector.h"
+#include "reactor.h"
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+
+namespace net {
+
+struct Resolver::Lookup {
+    //! Store the result and notify waiters.
+    void Complete(std::vector<SockAddr> result, std::exception_ptr err,
+                  Clock::duration ttl);
+
+    /**
+     * @brief Get the result of a completed lookup.
+     *
+     * @exception std::runtime_error The resolution failed.
+     */
+    std::vector<SockAddr> Result();
+
+    std::mutex mtx{};
+    std::condition_variable cv{};
+
+    bool done{ false };
+    std::vector<SockAddr> addrs{};
+    std::exception_ptr error{};
+
+    //! When the result expires.
+    Clock::time_point expiry{};
+
+    //! Handlers called once the lookup is done.
+    std::vector<std::function<void()>> on_done{};
+};
+
+void Resolver::Lookup::Complete(std::vector<SockAddr> result,
+                                std::exception_ptr err,
+                                const Clock::duration ttl) {
+    std::vector<std::function<void()>> handlers{};
+    {
+        const std::lock_guard lock{ mtx };
+        done = true;
+        addrs = std::move(result);
+        error = std::move(err);
+        expiry = Clock::now() + ttl;
+        handlers.swap(on_done);
+    }
+
+    cv.notify_all();
+    for (const auto& handler : handlers) {
+        handler();
+    }
+}
+
+std::vector<SockAddr> Resolver::Lookup::Result() {
+    const std::lock_guard lock{ mtx };
+    if (error != nullptr) {
+        std::rethrow_exception(error);
+    }
+
+    return addrs;
+}
+
+
+namespace {
+
+//! The state shared by a waiting coroutine and the thread waking it up.
+struct Wakeup {
+    Reactor* reactor;
+    std::coroutine_handle<> handle;
+
+    std::mutex mtx{};
+    bool resumed{ false };
+    bool cancelled{ false };
+
+    //! Whether the coroutine is still waiting. It is only accessed on the loop thread.
+    bool alive{ true };
+};
+
+//! Resume a waiting coroutine on its loop once.
+void Wake(const std::shared_ptr<Wakeup>& wakeup, const bool cancel) noexcept {
+    {
+        const std::lock_guard lock{ wakeup->mtx };
+        if (wakeup->resumed) {
+            return;
+        }
+
+        wakeup->resumed = true;
+        wakeup->cancelled = cancel;
+    }
+
+    try {
+        wakeup->reactor->Post([wakeup] {
+            if (wakeup->alive) {
+                wakeup->handle.resume();
+            }
+        });
+    } catch (...) {
+    }
+}
+
+//! The awaiter waiting for a lookup to complete.
+class LookupAwaiter final {
+public:
+    LookupAwaiter(Reactor& reactor, Resolver::Lookup& lookup,
+                  std::stop_token stop_token) noexcept :
+        reactor_{ reactor },
+        lookup_{ lookup },
+        stop_token_{ std::move(stop_token) } {}
+
+    ~LookupAwaiter() noexcept {
+        on_stop_.reset();
+        if (wakeup_ != nullptr) {
+            wakeup_->alive = false;
+        }
+    }
+
+    LookupAwaiter(const LookupAwaiter&) = delete;
+
+    LookupAwaiter& operator=(const LookupAwaiter&) = delete;
+
+    bool await_ready() {
+        if (stop_token_.stop_requested()) {
+            cancelled_ = true;
+            return true;
+        }
+
+        const std::lock_guard lock{ lookup_.mtx };
+        return lookup_.done;
+    }
+
+    bool await_suspend(const std::coroutine_handle<> handle) {
+        wakeup_ = std::make_shared<Wakeup>(&reactor_, handle);
+        {
+            const std::lock_guard lock{ lookup_.mtx };
+            if (lookup_.done) {
+                return false;
+            }
+
+            lookup_.on_done.emplace_back(
+                [wakeup{ wakeup_ }] { Wake(wakeup, false); });
+        }
+
+        if (stop_token_.stop_possible()) {
+            on_stop_.emplace(stop_token_, Canceller{ wakeup_ });
+        }
+
+        return true;
+    }
+
+    /**
+     * @exception std::system_error The wait has been cancelled.
+     */
+    void await_resume() const {
+        if (cancelled_ || (wakeup_ != nullptr && wakeup_->cancelled)) {
+            throw std::system_error{ std::make_error_code(
+                std::errc::operation_canceled) };
+        }
+    }
+
+private:
+    struct Canceller {
+        void operator()() const noexcept {
+            Wake(wakeup, true);
+        }
+
+        std::shared_ptr<Wakeup> wakeup;
+    };
+
+    Reactor& reactor_;
+    Resolver::Lookup& lookup_;
+    std::stop_token stop_token_;
+
+    std::shared_ptr<Wakeup> wakeup_{};
+    bool cancelled_{ false };
+    std::optional<std::stop_callback<Canceller>> on_stop_{};
+};
+
+}  // namespace
+
+
+Resolver::Resolver(const Clock::duration ttl) noexcept : ttl_{ ttl } {}
+
+Resolver::~Resolver() noexcept {
+    Join();
+}
+
+void Resolver::Prefetch(const std::string_view host, const std::uint16_t port) {
+    Find(host, port);
+}
+
+std::vector<SockAddr> Resolver::Resolve(const std::string_view host,
+                                        const std::uint16_t port) {
+    const auto lookup{ Find(host, port) };
+    {
+        std::unique_lock lock{ lookup->mtx };
+        lookup->cv.wait(lock, [&lookup] { return lookup->done; });
+    }
+
+    return lookup->Result();
+}
+
+Task<std::vector<SockAddr>> Resolver::AsyncResolve(
+    const std::string host, const std::uint16_t port,
+    const std::stop_token stop_token) {
+    const auto lookup{ Find(host, port) };
+    co_await LookupAwaiter{ Executor::Current().EventLoop(), *lookup,
+                            stop_token };
+    co_return lookup->Result();
+}
+
+void Resolver::Clear() noexcept {
+    const std::lock_guard lock{ mtx_ };
+    cache_.clear();
+}
+
+void Resolver::Join() noexcept {
+    decltype(threads_) threads{};
+    {
+        const std::lock_guard lock{ mtx_ };
+        threads.swap(threads_);
+    }
+
+    // Lookup threads never take the lock of the resolver, so they are joined without it.
+    for (auto& [lookup, thread] : threads) {
+        thread.join();
+    }
+}
+
+std::shared_ptr<Resolver::Lookup> Resolver::Find(const std::string_view host,
+                                                 const std::uint16_t port) {
+    const std::lock_guard lock{ mtx_ };
+    auto& lookup{ cache_[{ std::string{ host }, port }] };
+    if (lookup != nullptr) {
+        const std::lock_guard lookup_lock{ lookup->mtx };
+        if (!lookup->done
+            || (lookup->error == nullptr && lookup->expiry > Clock::now())) {
+            return lookup;
+        }
+    }
+
+    lookup = std::make_shared<Lookup>();
+
+    // A numeric address needs no lookup thread.
+    try {
+        lookup->Complete({ SockAddr{ std::string{ host }, port } }, nullptr,
+                         ttl_);
+        return lookup;
+    } catch (const std::invalid_argument&) {
+    }
+
+    // The thread is stored without throwing once it has started.
+    JoinDone();
+    threads_.reserve(threads_.size() + 1);
+    std::thread thread{ [lookup{ lookup }, host{ std::string{ host } }, port,
+                         ttl{ ttl_ }] {
+        std::vector<SockAddr> addrs{};
+        std::exception_ptr error{};
+        try {
+            addrs = net::Resolve(host, port);
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lookup->Complete(std::move(addrs), std::move(error), ttl);
+    } };
+
+    threads_.emplace_back(lookup, std::move(thread));
+    return lookup;
+}
+
+void Resolver::JoinDone() noexcept {
+    // A done lookup only has to finish calling its handlers, so joining it is quick.
+    std::erase_if(threads_, [](auto& entry) {
+        auto& [lookup, thread] = entry;
+        {
+            const std::lock_guard lock{ lookup->mtx };
+            if (!lookup->done) {
+                return false;
+            }
+        }
+
+        thread.join();
+        return true;
+    });
+}
+
+}  // namespace net
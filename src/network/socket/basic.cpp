@@ -2,6 +2,8 @@
 
 #include "socket/basic.h"
 
+#include <algorithm>
+#include <array>
 #include <limits>
 
 
@@ -13,4 +15,50 @@ void CheckSizeLimit(const std::size_t size, const std::string_view msg) {
     }
 }
 
+std::size_t SendBuffers(const SocketId id,
+                        std::span<const std::span<const std::byte>> buffers) {
+    buffers = buffers.first(std::min(buffers.size(), max_send_buffers));
+
+    std::size_t total{ 0 };
+    for (const auto buffer : buffers) {
+        total += buffer.size_bytes();
+    }
+
+    CheckSizeLimit(total, "The size of data is too large to send.");
+
+#ifdef _WIN32
+    std::array<WSABUF, max_send_buffers> vecs{};
+    for (std::size_t i{ 0 }; i != buffers.size(); ++i) {
+        vecs[i].buf = const_cast<CHAR*>(
+            reinterpret_cast<const CHAR*>(buffers[i].data()));
+        vecs[i].len = static_cast<ULONG>(buffers[i].size_bytes());
+    }
+
+    DWORD sent{ 0 };
+    if (WSASend(id, vecs.data(), static_cast<DWORD>(buffers.size()), &sent, 0,
+                nullptr, nullptr)
+        == socket_error) {
+        ThrowLastSocketError();
+    }
+
+    return static_cast<std::size_t>(sent);
+#else
+    std::array<iovec, max_send_buffers> vecs{};
+    for (std::size_t i{ 0 }; i != buffers.size(); ++i) {
+        vecs[i].iov_base = const_cast<std::byte*>(buffers[i].data());
+        vecs[i].iov_len = buffers[i].size_bytes();
+    }
+
+    msghdr msg{};
+    msg.msg_iov = vecs.data();
+    msg.msg_iovlen = buffers.size();
+    if (const auto sent{ sendmsg(id, &msg, send_flags) };
+        sent != socket_error) {
+        return static_cast<std::size_t>(sent);
+    } else {
+        ThrowLastSocketError();
+    }
+#endif  // _WIN32
+}
+
 }
\ No newline at end of file
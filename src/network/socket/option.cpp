@@ -0,0 +1,104 @@
+#include "socket/option.h"
+
+#include <functional>
+#include <stdexcept>
+
+
+namespace net {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+//! Keep-alive timings detecting a lost peer in about 16 seconds.
+constexpr KeepAliveTimings short_keep_alive{ .idle{ 10s },
+                                             .interval{ 2s },
+                                             .count{ 3 } };
+
+}  // namespace
+
+const LatencyProfile LatencyProfile::standard{ .name{ "Default" } };
+
+const LatencyProfile LatencyProfile::low_latency{
+    .name{ "LowLatency" },
+    .no_delay{ true },
+    .quick_ack{ true },
+    .send_buffer{ 64 * 1024 },
+    .recv_buffer{ 64 * 1024 },
+    .keep_alive{ short_keep_alive },
+    // The interactive priority, which does not need special permissions.
+    .priority{ 6 }
+};
+
+const LatencyProfile LatencyProfile::busy_poll_latency{
+    .name{ "BusyPoll" },
+    .no_delay{ true },
+    .quick_ack{ true },
+    .send_buffer{ 64 * 1024 },
+    .recv_buffer{ 64 * 1024 },
+    .keep_alive{ short_keep_alive },
+    .busy_poll{ 50us },
+    .priority{ 6 }
+};
+
+const LatencyProfile LatencyProfile::throughput{
+    .name{ "Throughput" },
+    .send_buffer{ 1024 * 1024 },
+    .recv_buffer{ 1024 * 1024 },
+    .keep_alive{ KeepAliveTimings{
+        .idle{ 60s }, .interval{ 10s }, .count{ 5 } } }
+};
+
+const LatencyProfile& LatencyProfile::FromName(const std::string_view name) {
+    for (const auto& profile :
+         { std::cref(standard), std::cref(low_latency),
+           std::cref(busy_poll_latency), std::cref(throughput) }) {
+        if (profile.get().name == name) {
+            return profile.get();
+        }
+    }
+
+    throw std::invalid_argument{ "The latency profile does not exist." };
+}
+
+
+void ApplyLatencyProfile(const SocketId id, const LatencyProfile& profile) {
+    if (profile.no_delay) {
+        SetSocketOption<opt::NoDelay>(id, true);
+    }
+
+    if (profile.send_buffer.has_value()) {
+        SetSocketOption<opt::SendBuffer>(id, profile.send_buffer.value());
+    }
+
+    if (profile.recv_buffer.has_value()) {
+        SetSocketOption<opt::RecvBuffer>(id, profile.recv_buffer.value());
+    }
+
+    if (profile.keep_alive.has_value()) {
+        const auto& timings{ profile.keep_alive.value() };
+        SetSocketOption<opt::KeepAlive>(id, true);
+        SetSocketOption<opt::KeepIdle>(
+            id, static_cast<int>(timings.idle.count()));
+        SetSocketOption<opt::KeepInterval>(
+            id, static_cast<int>(timings.interval.count()));
+        SetSocketOption<opt::KeepCount>(id, timings.count);
+    }
+
+#ifdef __linux__
+    if (profile.quick_ack) {
+        SetSocketOption<opt::QuickAck>(id, true);
+    }
+
+    if (profile.busy_poll.has_value()) {
+        SetSocketOption<opt::BusyPoll>(
+            id, static_cast<int>(profile.busy_poll.value().count()));
+    }
+
+    if (profile.priority.has_value()) {
+        SetSocketOption<opt::Priority>(id, profile.priority.value());
+    }
+#endif  // __linux__
+}
+
+}  // namespace net
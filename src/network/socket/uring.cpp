@@ -0,0 +1,399 @@
+#include "socket/uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+
+namespace net {
+
+namespace {
+
+//! The ID of the registered buffer group.
+constexpr std::uint16_t buffer_group{ 0 };
+
+//! The maximum number of buffers in a buffer ring.
+constexpr std::uint16_t max_buffer_count{ 1 << 15 };
+
+[[noreturn]] void ThrowError(const int code) {
+    throw std::system_error{ code, std::system_category() };
+}
+
+template <typename T>
+T* Offset(void* const base, const std::uint32_t offset) noexcept {
+    return reinterpret_cast<T*>(static_cast<std::byte*>(base) + offset);
+}
+
+void* Map(const std::size_t size, const int fd, const off_t offset) {
+    const auto flags{ fd == -1 ? MAP_PRIVATE | MAP_ANONYMOUS
+                               : MAP_SHARED | MAP_POPULATE };
+    void* const addr{ mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd,
+                           offset) };
+    if (addr == MAP_FAILED) {
+        ThrowLastSocketError();
+    }
+
+    return addr;
+}
+
+}  // namespace
+
+
+UringTransport::UringTransport(const SocketId id, const UringOptions& options) :
+    socket_{ id }, options_{ options } {
+    if (options_.buffer_count == 0 || options_.buffer_count > max_buffer_count
+        || (options_.buffer_count & (options_.buffer_count - 1)) != 0) {
+        throw std::invalid_argument{
+            "The number of receive buffers must be a power of 2."
+        };
+    } else if (options_.buffer_size == 0) {
+        throw std::invalid_argument{ "The size of receive buffers is zero." };
+    }
+
+    try {
+        Setup();
+        ArmRecv();
+    } catch (...) {
+        Release();
+        throw;
+    }
+}
+
+UringTransport::~UringTransport() noexcept {
+    try {
+        for (const auto tag : { Tag::Recv, Tag::Send }) {
+            auto& sqe{ NextSqe() };
+            sqe.opcode = IORING_OP_ASYNC_CANCEL;
+            sqe.fd = -1;
+            sqe.addr = static_cast<std::uint64_t>(tag);
+            sqe.user_data = static_cast<std::uint64_t>(Tag::Cancel);
+        }
+
+        Enter(0);
+        Reap();
+        while (recv_armed_ || send_in_flight_) {
+            Enter(1);
+            Reap();
+        }
+    } catch (...) {
+    }
+
+    Release();
+}
+
+
+void UringTransport::Setup() {
+    io_uring_params params{};
+    ring_ = static_cast<int>(
+        syscall(__NR_io_uring_setup, options_.queue_depth, &params));
+    if (ring_ == -1) {
+        ThrowLastSocketError();
+    }
+
+    sq_ring_size_ =
+        params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if ((params.features & IORING_FEAT_SINGLE_MMAP) != 0) {
+        sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        sq_ring_ = Map(sq_ring_size_, ring_, IORING_OFF_SQ_RING);
+    } else {
+        sq_ring_ = Map(sq_ring_size_, ring_, IORING_OFF_SQ_RING);
+        cq_ring_ = Map(cq_ring_size_, ring_, IORING_OFF_CQ_RING);
+    }
+
+    void* const cq_ring{ cq_ring_ != nullptr ? cq_ring_ : sq_ring_ };
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(Map(sqes_size_, ring_, IORING_OFF_SQES));
+
+    sq_head_ = Offset<std::uint32_t>(sq_ring_, params.sq_off.head);
+    sq_tail_ = Offset<std::uint32_t>(sq_ring_, params.sq_off.tail);
+    sq_array_ = Offset<std::uint32_t>(sq_ring_, params.sq_off.array);
+    sq_mask_ = *Offset<std::uint32_t>(sq_ring_, params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    sq_local_tail_ = *sq_tail_;
+
+    cq_head_ = Offset<std::uint32_t>(cq_ring, params.cq_off.head);
+    cq_tail_ = Offset<std::uint32_t>(cq_ring, params.cq_off.tail);
+    cq_mask_ = *Offset<std::uint32_t>(cq_ring, params.cq_off.ring_mask);
+    cqes_ = Offset<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+
+    buf_ring_size_ = options_.buffer_count * sizeof(io_uring_buf);
+    buf_ring_ = static_cast<io_uring_buf*>(Map(buf_ring_size_, -1, 0));
+    buffers_.resize(static_cast<std::size_t>(options_.buffer_count)
+                    * options_.buffer_size);
+
+    io_uring_buf_reg reg{};
+    reg.ring_addr = reinterpret_cast<std::uint64_t>(buf_ring_);
+    reg.ring_entries = options_.buffer_count;
+    reg.bgid = buffer_group;
+    if (syscall(__NR_io_uring_register, ring_, IORING_REGISTER_PBUF_RING, &reg,
+                1)
+        == -1) {
+        ThrowLastSocketError();
+    }
+
+    for (std::uint16_t id{ 0 }; id != options_.buffer_count; ++id) {
+        Recycle(id);
+    }
+}
+
+void UringTransport::Release() noexcept {
+    if (ring_ != -1) {
+        close(ring_);
+        ring_ = -1;
+    }
+
+    for (const auto& [addr, size] :
+         { std::pair{ sq_ring_, sq_ring_size_ },
+           std::pair{ cq_ring_, cq_ring_size_ },
+           std::pair{ static_cast<void*>(sqes_), sqes_size_ },
+           std::pair{ static_cast<void*>(buf_ring_), buf_ring_size_ } }) {
+        if (addr != nullptr) {
+            munmap(addr, size);
+        }
+    }
+
+    sq_ring_ = cq_ring_ = nullptr;
+    sqes_ = nullptr;
+    buf_ring_ = nullptr;
+}
+
+
+std::size_t UringTransport::Send(const std::span<const std::byte> data) {
+    CheckSizeLimit(data.size_bytes(), "The size of data is too large to send.");
+    ThrowIfFailed();
+
+    pending_.insert(pending_.end(), data.begin(), data.end());
+    ++stats_.sends;
+    return data.size_bytes();
+}
+
+std::size_t UringTransport::Recv(const std::span<std::byte> buffer) {
+    CheckSizeLimit(buffer.size_bytes(),
+                   "The size of buffer is too large to receive data.");
+    if (buffer.empty()) {
+        return 0;
+    }
+
+    while (true) {
+        if (!ready_.empty()) {
+            auto& chunk{ ready_.front() };
+            const auto size{ std::min<std::size_t>(buffer.size_bytes(),
+                                                   chunk.size - chunk.offset) };
+            std::memcpy(buffer.data(), BufferAt(chunk.id) + chunk.offset, size);
+            chunk.offset += static_cast<std::uint32_t>(size);
+            if (chunk.offset == chunk.size) {
+                Recycle(chunk.id);
+                ready_.pop_front();
+            }
+
+            return size;
+        }
+
+        ThrowIfFailed();
+        if (eof_) {
+            return 0;
+        }
+
+        if (!recv_armed_) {
+            ArmRecv();
+        }
+
+        if (!pending_.empty()) {
+            PrepareSend();
+        }
+
+        Enter(1);
+        Reap();
+    }
+}
+
+void UringTransport::Flush() {
+    if (!pending_.empty()) {
+        PrepareSend();
+    }
+
+    if (to_submit_ != 0) {
+        Enter(0);
+    }
+
+    Reap();
+    ThrowIfFailed();
+}
+
+const UringStats& UringTransport::Stats() const noexcept {
+    return stats_;
+}
+
+
+io_uring_sqe& UringTransport::NextSqe() {
+    const auto head{ std::atomic_ref{ *sq_head_ }.load(
+        std::memory_order_acquire) };
+    if (sq_local_tail_ - head == sq_entries_) {
+        Enter(0);
+    }
+
+    const auto idx{ sq_local_tail_ & sq_mask_ };
+    auto& sqe{ sqes_[idx] };
+    std::memset(&sqe, 0, sizeof(sqe));
+    sq_array_[idx] = idx;
+    ++sq_local_tail_;
+    ++to_submit_;
+    return sqe;
+}
+
+void UringTransport::Enter(const std::uint32_t min_complete) {
+    std::atomic_ref{ *sq_tail_ }.store(sq_local_tail_,
+                                       std::memory_order_release);
+    const auto flags{ min_complete != 0 ? IORING_ENTER_GETEVENTS : 0U };
+    while (true) {
+        ++stats_.enters;
+        if (const auto submitted{ syscall(__NR_io_uring_enter, ring_,
+                                          to_submit_, min_complete, flags,
+                                          nullptr, 0) };
+            submitted != -1) {
+            to_submit_ -= static_cast<std::uint32_t>(submitted);
+            return;
+        } else if (errno != EINTR) {
+            ThrowLastSocketError();
+        }
+    }
+}
+
+void UringTransport::Reap() noexcept {
+    auto head{ *cq_head_ };
+    const auto tail{ std::atomic_ref{ *cq_tail_ }.load(
+        std::memory_order_acquire) };
+    for (; head != tail; ++head) {
+        Complete(cqes_[head & cq_mask_]);
+    }
+
+    std::atomic_ref{ *cq_head_ }.store(head, std::memory_order_release);
+}
+
+void UringTransport::Complete(const io_uring_cqe& cqe) noexcept {
+    switch (static_cast<Tag>(cqe.user_data)) {
+        case Tag::Recv: {
+            ++stats_.recv_completions;
+            if ((cqe.flags & IORING_CQE_F_MORE) == 0) {
+                recv_armed_ = false;
+            }
+
+            const bool has_buffer{ (cqe.flags & IORING_CQE_F_BUFFER) != 0 };
+            const auto id{ static_cast<std::uint16_t>(
+                cqe.flags >> IORING_CQE_BUFFER_SHIFT) };
+            if (cqe.res > 0) {
+                assert(has_buffer);
+                const auto size{ static_cast<std::uint32_t>(cqe.res) };
+                ready_.push_back({ .id{ id }, .offset{ 0 }, .size{ size } });
+                break;
+            } else if (has_buffer) {
+                Recycle(id);
+            }
+
+            if (cqe.res == 0) {
+                eof_ = true;
+            } else if (cqe.res != -ENOBUFS && cqe.res != -ECANCELED) {
+                // Running out of buffers only disarms the receive.
+                // It is re-armed after buffers are recycled.
+                error_ = -cqe.res;
+            }
+
+            break;
+        }
+        case Tag::Send: {
+            send_in_flight_ = false;
+            if (cqe.res < 0) {
+                if (cqe.res != -ECANCELED) {
+                    error_ = -cqe.res;
+                }
+            } else {
+                inflight_sent_ += static_cast<std::size_t>(cqe.res);
+                if (inflight_sent_ < inflight_.size()) {
+                    try {
+                        QueueSend();
+                    } catch (const std::system_error& err) {
+                        error_ = err.code().value();
+                    }
+                } else {
+                    inflight_.clear();
+                }
+            }
+
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+
+void UringTransport::ArmRecv() {
+    auto& sqe{ NextSqe() };
+    sqe.opcode = IORING_OP_RECV;
+    sqe.fd = socket_;
+    sqe.ioprio = IORING_RECV_MULTISHOT;
+    sqe.flags = IOSQE_BUFFER_SELECT;
+    sqe.buf_group = buffer_group;
+    sqe.user_data = static_cast<std::uint64_t>(Tag::Recv);
+    recv_armed_ = true;
+}
+
+void UringTransport::PrepareSend() {
+    // Only one send is in flight, so the order of data is kept.
+    while (send_in_flight_) {
+        Enter(1);
+        Reap();
+    }
+
+    ThrowIfFailed();
+    inflight_.swap(pending_);
+    pending_.clear();
+    inflight_sent_ = 0;
+    QueueSend();
+}
+
+void UringTransport::QueueSend() {
+    auto& sqe{ NextSqe() };
+    sqe.opcode = IORING_OP_SEND;
+    sqe.fd = socket_;
+    sqe.addr =
+        reinterpret_cast<std::uint64_t>(inflight_.data() + inflight_sent_);
+    sqe.len = static_cast<std::uint32_t>(inflight_.size() - inflight_sent_);
+    sqe.msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+    sqe.user_data = static_cast<std::uint64_t>(Tag::Send);
+    send_in_flight_ = true;
+}
+
+void UringTransport::Recycle(const std::uint16_t id) noexcept {
+    auto& buf{ buf_ring_[buf_tail_ & (options_.buffer_count - 1)] };
+    buf.addr = reinterpret_cast<std::uint64_t>(BufferAt(id));
+    buf.len = options_.buffer_size;
+    buf.bid = id;
+    ++buf_tail_;
+    std::atomic_ref{ buf_ring_[0].resv }.store(buf_tail_,
+                                               std::memory_order_release);
+}
+
+std::byte* UringTransport::BufferAt(const std::uint16_t id) noexcept {
+    return buffers_.data()
+           + static_cast<std::size_t>(id) * options_.buffer_size;
+}
+
+void UringTransport::ThrowIfFailed() const {
+    if (error_ != 0) {
+        ThrowError(error_);
+    }
+}
+
+}  // namespace net